@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+#include <SFML/System/Time.hpp>
+
+namespace core
+{
+
+/**
+ * \brief Time source in milliseconds since epoch, injected where the game reads the current time so it can be
+ * stepped faster than real time (replays, bots, benchmarks).
+ */
+class ClockInterface
+{
+public:
+    virtual ~ClockInterface() = default;
+    [[nodiscard]] virtual unsigned long long GetTimeMs() const = 0;
+};
+
+/**
+ * \brief Wall clock, the default time source
+ */
+class SystemClock final : public ClockInterface
+{
+public:
+    [[nodiscard]] unsigned long long GetTimeMs() const override;
+    /**
+     * \brief Shared instance used by default by the systems reading the time
+     */
+    static const SystemClock& Get();
+};
+
+/**
+ * \brief Clock only moving forward when advanced, to drive a simulation independently of real time
+ */
+class ManualClock final : public ClockInterface
+{
+public:
+    explicit ManualClock(unsigned long long startTimeMs = 0);
+    void Advance(sf::Time dt);
+    [[nodiscard]] unsigned long long GetTimeMs() const override;
+private:
+    //Kept in microseconds so advancing by small steps does not drift
+    std::int64_t currentTimeUs_ = 0;
+};
+
+} // namespace core
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <utils/log.h>
+#include <utils/memory.h>
+#include <algorithm>
 #include <cstdint>
+#include <span>
 #include <engine/globals.h>
 #include <engine/entity.h>
+#include <engine/world_arena.h>
 
 namespace core
 {
@@ -28,12 +32,22 @@ namespace core
     public:
         ComponentManager(EntityManager& entityManager) : entityManager_(entityManager)
         {
-            components_.resize(entityInitNmb);
+            storage_.resize(entityManager.GetEntitiesSize());
+            components_ = storage_;
+        }
+        /**
+         * \brief Components allocated in arena, their number is fixed to the entities capacity at construction
+         */
+        ComponentManager(EntityManager& entityManager, WorldArena& arena) : entityManager_(entityManager),
+            components_(arena.Allocate<T>(entityManager.GetEntitiesSize())), isArenaBacked_(true)
+        {
+            entityManager.FixCapacity();
         }
         virtual ~ComponentManager() = default;
 
+        //components_ may point into storage_, copying or moving the manager would leave it dangling
         ComponentManager(const ComponentManager&) = delete;
-        ComponentManager& operator=(ComponentManager&) = delete;
+        ComponentManager& operator=(const ComponentManager&) = delete;
         ComponentManager(ComponentManager&&) = delete;
         ComponentManager& operator=(ComponentManager&&) = delete;
 
@@ -46,11 +60,23 @@ namespace core
 
         void SetComponent(Entity entity, const T& value);
 
-        [[nodiscard]] const std::vector<T>& GetAllComponents() const;
-        void CopyAllComponents(const std::vector<T>& components);
+        [[nodiscard]] std::span<const T> GetAllComponents() const;
+        /**
+         * \brief Components allocated in a world arena have a fixed count, copying another count fails without copying
+         */
+        bool CopyAllComponents(std::span<const T> components);
+        /**
+         * \brief Bytes reserved by the component array compared to the components of the entities that have one
+         */
+        [[nodiscard]] MemoryUsage GetMemoryUsage() const;
     protected:
         EntityManager& entityManager_;
-        std::vector<T> components_;
+        /**
+         * \brief Owned components, unused when the components live in a world arena
+         */
+        std::vector<T> storage_;
+        std::span<T> components_;
+        bool isArenaBacked_ = false;
     };
 
     template <typename T, Component C>
@@ -62,12 +88,18 @@ namespace core
             return;
         }
         // Resize components array if too small
-        auto currentSize = components_.size();
-        while (entity >= currentSize)
+        if (entity >= components_.size())
         {
-            auto newSize = currentSize + currentSize / 2;
-            components_.resize(newSize);
-            currentSize = newSize;
+            const auto newSize = GetGrownCapacity(components_.size(), static_cast<std::size_t>(entity) + 1);
+            entityManager_.CheckGrowth("components", newSize);
+            if (isArenaBacked_)
+            {
+                CORE_LOG_ERROR("[Component] Cannot grow components allocated in a world arena to {}", newSize);
+                return;
+            }
+            const MemoryTagScope memoryTagScope(MemoryTag::Components);
+            storage_.resize(newSize);
+            components_ = storage_;
         }
 
         entityManager_.AddComponent(entity, C);
@@ -98,14 +130,44 @@ namespace core
     }
 
     template <typename T, Component C>
-    const std::vector<T>& ComponentManager<T, C>::GetAllComponents() const
+    std::span<const T> ComponentManager<T, C>::GetAllComponents() const
     {
         return components_;
     }
 
     template <typename T, Component C>
-    void ComponentManager<T, C>::CopyAllComponents(const std::vector<T>& components)
+    bool ComponentManager<T, C>::CopyAllComponents(std::span<const T> components)
+    {
+        if (components.size() != components_.size())
+        {
+            if (isArenaBacked_)
+            {
+                CORE_LOG_ERROR("[Component] Copying {} components in a world arena of {} components",
+                    components.size(), components_.size());
+                return false;
+            }
+            storage_.resize(components.size());
+            components_ = storage_;
+        }
+        std::copy(components.begin(), components.end(), components_.begin());
+        return true;
+    }
+
+    template <typename T, Component C>
+    MemoryUsage ComponentManager<T, C>::GetMemoryUsage() const
     {
-        components_ = components;
+        std::size_t liveCount = 0;
+        for (Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
+        {
+            if (entityManager_.HasComponent(entity, C))
+            {
+                liveCount++;
+            }
+        }
+        if (isArenaBacked_)
+        {
+            return { components_.size() * sizeof(T), liveCount * sizeof(T) };
+        }
+        return core::GetMemoryUsage(storage_, liveCount);
     }
 } // namespace core
@@ -1,8 +1,17 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Window/Event.hpp>
+
+#include "engine/frame_pacer.h"
+#include "graphics/render_snapshot.h"
+#include "graphics/sprite_batch.h"
+#include "utils/triple_buffer.h"
 
 namespace core
 {
@@ -19,15 +28,58 @@ public:
     void RegisterOnEvent(OnEventInterface*);
     void RegisterDraw(DrawInterface*);
     void RegisterDrawImGui(DrawImGuiInterface*);
+    /**
+     * \brief ImGui windows that do not read the systems, with threaded rendering they are drawn every frame
+     * without waiting for the simulation thread
+     */
+    void RegisterRenderImGui(DrawImGuiInterface*);
+    void RegisterRenderSnapshot(RenderSnapshotInterface*);
+    /**
+     * \brief Runs the systems on a simulation thread that publishes a RenderSnapshot after each update,
+     * the main thread only polls the events and draws the last snapshot, so a long update does not drop frames.
+     * The DrawInterface are not used in this mode. The ImGui windows of RegisterDrawImGui read the systems, so the
+     * main thread waits for the current update before drawing them. Snapshots are written every simulationPeriod,
+     * so the rendered motion is limited to that rate even on faster displays.
+     */
+    void SetThreadedRendering(bool threadedRendering) { threadedRendering_ = threadedRendering; }
+    /**
+     * \brief Paces the drawing loop, register it with RegisterDrawImGui to tweak it at runtime
+     */
+    [[nodiscard]] FramePacer& GetFramePacer() { return framePacer_; }
+    /**
+     * \brief Sprite draw calls of the last snapshot drawn with threaded rendering, read it from the main thread
+     */
+    [[nodiscard]] std::size_t GetSpriteDrawCallCount() const { return spriteBatch_.GetDrawCallCount(); }
+    static constexpr float simulationPeriod = 1.0f / 120.0f;
 protected:
     void Init();
     void Update(sf::Time dt);
     void Destroy();
+    void PollEvents();
+    void ApplyVerticalSync();
+    void RunThreaded();
+    void SimulationLoop();
     std::vector<SystemInterface*> systems_;
     std::vector<OnEventInterface*> eventInterfaces_;
     std::vector<DrawInterface*> drawInterfaces_;
     std::vector<DrawImGuiInterface*> drawImGuiInterfaces_;
+    std::vector<DrawImGuiInterface*> renderImGuiInterfaces_;
+    std::vector<RenderSnapshotInterface*> renderSnapshotInterfaces_;
     std::unique_ptr<sf::RenderWindow> window_;
+    FramePacer framePacer_;
+    bool verticalSync_ = false;
+
+    bool threadedRendering_ = false;
+    std::atomic<bool> isRunning_{ false };
+    /**
+     * \brief Held by the simulation thread while the systems update
+     */
+    std::mutex simulationMutex_;
+    std::mutex eventMutex_;
+    std::vector<sf::Event> pendingEvents_;
+    sf::View windowView_;
+    TripleBuffer<RenderSnapshot> renderSnapshots_;
+    SpriteBatch spriteBatch_;
 };
 
 } // namespace core
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 #include <limits>
+#include <string_view>
+
+#include "utils/memory.h"
 
 namespace core
 {
@@ -11,6 +15,14 @@ using Entity = std::uint32_t;
 //qui  quel component dans le manager
 using EntityMask = std::uint32_t;
 
+/**
+ * \brief Size of the entity and component arrays grown by 1.5 to hold at least minSize elements
+ */
+constexpr std::size_t GetGrownCapacity(std::size_t currentSize, std::size_t minSize)
+{
+    return std::max(currentSize + currentSize / 2, minSize);
+}
+
 /**
  * \brief Manages the entities in an array using bitwise operations to know if it has components.
  */
@@ -30,11 +42,53 @@ public:
     [[nodiscard]] bool EntityExists(Entity entity) const;
 
     [[nodiscard]] std::size_t GetEntitiesSize() const;
+    /**
+     * \brief Bytes reserved by the entity masks compared to the masks of the existing entities
+     */
+    [[nodiscard]] MemoryUsage GetMemoryUsage() const;
+    /**
+     * \brief While the capacity is locked, growing the entities or a component array is an error.
+     * Used around the simulation so a rollback never reallocates.
+     */
+    void SetCapacityLocked(bool capacityLocked) { capacityLocked_ = capacityLocked; }
+    [[nodiscard]] bool IsCapacityLocked() const { return capacityLocked_; }
+    /**
+     * \brief Called before growing the entities or a component array to newSize, asserts when the capacity is locked
+     */
+    void CheckGrowth(std::string_view arrayName, std::size_t newSize) const;
+    /**
+     * \brief Called by the component managers allocated in a world arena, from then on CreateEntity returns
+     * INVALID_ENTITY instead of growing past the arena
+     */
+    void FixCapacity() { capacityFixed_ = true; }
+    [[nodiscard]] bool IsCapacityFixed() const { return capacityFixed_; }
 
     static constexpr Entity INVALID_ENTITY = std::numeric_limits<Entity>::max();
     static constexpr EntityMask INVALID_ENTITY_MASK = 0u;
 private:
     std::vector<EntityMask> entityMasks_;
+    bool capacityLocked_ = false;
+    bool capacityFixed_ = false;
+};
+
+/**
+ * \brief Locks the capacity of entityManager for the rest of the scope when lock is true
+ */
+class CapacityLockScope
+{
+public:
+    CapacityLockScope(EntityManager& entityManager, bool lock) :
+        entityManager_(entityManager), previousLocked_(entityManager.IsCapacityLocked())
+    {
+        entityManager_.SetCapacityLocked(previousLocked_ || lock);
+    }
+    ~CapacityLockScope() { entityManager_.SetCapacityLocked(previousLocked_); }
+
+    CapacityLockScope(const CapacityLockScope&) = delete;
+    CapacityLockScope& operator=(const CapacityLockScope&) = delete;
+private:
+    EntityManager& entityManager_;
+    bool previousLocked_;
 };
 
 } // namespace core
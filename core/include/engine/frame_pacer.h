@@ -0,0 +1,97 @@
+#pragma once
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+
+#include "graphics/graphics.h"
+
+namespace core
+{
+
+/**
+ * \brief Timings of the frames of the last second
+ */
+struct FramePacerStats
+{
+    float framesPerSecond = 0.0f;
+    sf::Time averageFrameTime;
+    sf::Time maxFrameTime;
+    /**
+     * \brief Time spent updating and drawing, without the waiting
+     */
+    sf::Time averageWorkTime;
+    /**
+     * \brief How late the waits end compared to the frame deadline
+     */
+    sf::Time averageWaitError;
+    /**
+     * \brief Time before the deadline at which the last wait stopped sleeping
+     */
+    sf::Time spinTime;
+};
+
+/**
+ * \brief Caps the frame rate of a loop: sleeps until shortly before the next frame deadline and yields the rest,
+ * as sleeping is only accurate to the scheduler granularity. The spin time before the deadline follows the
+ * measured oversleep of the previous waits, so it stays short on precise schedulers.
+ * With VSync, display() already waits for the screen, the target frame rate can then be set to 0 (uncapped).
+ */
+class FramePacer : public DrawImGuiInterface
+{
+public:
+    /**
+     * \brief Starts a new frame and returns the time since the start of the previous one
+     */
+    sf::Time BeginFrame();
+    /**
+     * \brief Waits for the deadline of the next frame
+     */
+    void EndFrame();
+    /**
+     * \brief 0 does not cap the frame rate
+     */
+    void SetTargetFrameRate(float framesPerSecond) { targetFrameRate_ = framesPerSecond; }
+    [[nodiscard]] float GetTargetFrameRate() const { return targetFrameRate_; }
+    void SetVerticalSync(bool verticalSync) { verticalSync_ = verticalSync; }
+    [[nodiscard]] bool IsVerticalSyncEnabled() const { return verticalSync_; }
+    /**
+     * \brief Bounds of the time before the deadline at which the sleep stops and the pacer only yields,
+     * the spin time adapts between them to the worst recent oversleep
+     */
+    void SetSpinTimeRange(sf::Time minSpinTime, sf::Time maxSpinTime);
+    [[nodiscard]] const FramePacerStats& GetStats() const { return stats_; }
+    void DrawImGui() override;
+private:
+    void UpdateStats(sf::Time frameTime, sf::Time workTime, sf::Time waitError);
+    /**
+     * \brief Keeps a decaying maximum of the oversleeps and spins for it plus a safety margin
+     */
+    void UpdateSpinTime(sf::Time oversleep);
+
+    sf::Clock clock_;
+    sf::Time frameStart_;
+    sf::Time nextFrameDeadline_;
+    float targetFrameRate_ = 120.0f;
+    bool verticalSync_ = false;
+    sf::Time minSpinTime_ = sf::microseconds(100);
+    sf::Time maxSpinTime_ = sf::milliseconds(4);
+    sf::Time spinTime_ = sf::milliseconds(2);
+    sf::Time sleepOvershoot_;
+    /**
+     * \brief Factor applied to the oversleep maximum at each wait, it halves in about 70 waits
+     */
+    static constexpr float overshootDecay = 0.99f;
+    static constexpr sf::Int64 spinMarginMicroseconds = 250;
+
+    FramePacerStats stats_;
+    sf::Time statsStart_;
+    unsigned statsFrameCount_ = 0;
+    sf::Time frameTimeSum_;
+    sf::Time maxFrameTime_;
+    sf::Time workTimeSum_;
+    sf::Time waitErrorSum_;
+    sf::Time lastWorkTime_;
+    sf::Time lastWaitError_;
+};
+
+} // namespace core
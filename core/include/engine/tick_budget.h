@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+
+namespace core
+{
+
+/**
+ * \brief Time spent by one system per tick compared to its budget
+ */
+struct TickBudgetStats
+{
+    const char* name = nullptr;
+    sf::Time budget;
+    sf::Time lastTime;
+    sf::Time maxTime;
+    sf::Time totalTime;
+    std::uint64_t tickCount = 0;
+    std::uint64_t overrunCount = 0;
+    /**
+     * \brief Overruns and worst tick of the last complete overrun window
+     */
+    std::uint32_t windowOverrunCount = 0;
+    sf::Time windowMaxTime;
+    std::uint32_t currentWindowOverrunCount = 0;
+    sf::Time currentWindowMaxTime;
+};
+
+/**
+ * \brief Accounts the time per tick of a sequence of systems against their budgets.
+ * The overruns are counted over a rolling window of overrunWindow seconds and optionally logged once per window.
+ */
+class TickBudgetTracker
+{
+public:
+    using SystemId = std::size_t;
+    SystemId AddSystem(const char* name, sf::Time budget);
+    void SetBudget(SystemId systemId, sf::Time budget) { stats_[systemId].budget = budget; }
+    void Record(SystemId systemId, sf::Time tickTime);
+    /**
+     * \brief Closes the overrun window when it is over and logs the systems that overran in it
+     */
+    void Update();
+    void SetLogOverruns(bool logOverruns) { logOverruns_ = logOverruns; }
+    [[nodiscard]] const std::vector<TickBudgetStats>& GetStats() const { return stats_; }
+    void Reset();
+    void DrawImGui();
+
+    static constexpr float overrunWindow = 1.0f;
+private:
+    std::vector<TickBudgetStats> stats_;
+    sf::Clock windowClock_;
+    bool logOverruns_ = false;
+};
+
+/**
+ * \brief Records the time between its construction and its destruction in a TickBudgetTracker
+ */
+class TickBudgetScope
+{
+public:
+    TickBudgetScope(TickBudgetTracker& tracker, TickBudgetTracker::SystemId systemId) :
+        tracker_(tracker), systemId_(systemId), start_(std::chrono::steady_clock::now())
+    {
+    }
+    ~TickBudgetScope()
+    {
+        const auto duration = std::chrono::steady_clock::now() - start_;
+        tracker_.Record(systemId_, sf::microseconds(
+            std::chrono::duration_cast<std::chrono::microseconds>(duration).count()));
+    }
+    TickBudgetScope(const TickBudgetScope&) = delete;
+    TickBudgetScope& operator=(const TickBudgetScope&) = delete;
+private:
+    TickBudgetTracker& tracker_;
+    TickBudgetTracker::SystemId systemId_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace core
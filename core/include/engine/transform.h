@@ -29,30 +29,44 @@ public:
     using ComponentManager::ComponentManager;
 };
 
+/**
+ * \brief Position, scale and rotation of the entities. Entities whose transform changed are tracked so that
+ * only them get propagated to other transform managers or sprites.
+ */
 class TransformManager
 {
 public:
     TransformManager(EntityManager& entityManager);
 
     [[nodiscard]] Vec2f GetPosition(Entity entity) const;
-    [[nodiscard]] const std::vector<Vec2f>& GetAllPositions() const;
+    [[nodiscard]] std::span<const Vec2f> GetAllPositions() const;
     void SetPosition(Entity entity, Vec2f position);
 
     [[nodiscard]] Vec2f GetScale(Entity entity) const;
-    [[nodiscard]] const std::vector<Vec2f>& GetAllScales() const;
+    [[nodiscard]] std::span<const Vec2f> GetAllScales() const;
     void SetScale(Entity entity, Vec2f scale);
 
     [[nodiscard]] degree_t GetRotation(Entity entity) const;
-    [[nodiscard]] const std::vector<degree_t>& GetAllRotations() const;
+    [[nodiscard]] std::span<const degree_t> GetAllRotations() const;
     void SetRotation(Entity entity, degree_t rotation);
 
     void AddComponent(Entity entity);
     void RemoveComponent(Entity entity);
+
+    /**
+     * \brief Entities whose transform changed since the last ClearDirtyEntities, each entity is listed once
+     */
+    [[nodiscard]] const std::vector<Entity>& GetDirtyEntities() const { return dirtyEntities_; }
+    void ClearDirtyEntities();
+    void MarkDirty(Entity entity);
+    [[nodiscard]] MemoryUsage GetMemoryUsage() const;
     
 private:
     PositionManager positionManager_;
     ScaleManager scaleManager_;
     RotationManager rotationManager_;
+    std::vector<std::uint8_t> dirtyFlags_;
+    std::vector<Entity> dirtyEntities_;
 };
 
 }
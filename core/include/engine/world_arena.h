@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+#include "utils/log.h"
+#include "utils/memory.h"
+
+namespace core
+{
+
+/**
+ * \brief Fixed size block holding the trivially copyable simulation state of a world, so saving or restoring the
+ * whole state is one memcpy of GetSize bytes. Arenas allocated with the same sequence of types and counts have the
+ * same layout and can be copied into each other.
+ */
+class WorldArena
+{
+public:
+    explicit WorldArena(std::size_t capacity);
+
+    WorldArena(const WorldArena&) = delete;
+    WorldArena& operator=(const WorldArena&) = delete;
+
+    /**
+     * \brief Value initialized array of count T at the end of the arena, empty if the capacity is exceeded
+     */
+    template<typename T>
+    [[nodiscard]] std::span<T> Allocate(std::size_t count);
+    /**
+     * \brief Upper bound of the bytes used by Allocate<T>(count), alignment padding included
+     */
+    template<typename T>
+    [[nodiscard]] static constexpr std::size_t GetAllocationSize(std::size_t count)
+    {
+        return count * sizeof(T) + alignof(T) - 1;
+    }
+    /**
+     * \brief Copies the state of other, both arenas must have the same layout
+     */
+    void CopyFrom(const WorldArena& other);
+    [[nodiscard]] std::span<const std::byte> GetBytes() const { return { data_.get(), size_ }; }
+    /**
+     * \brief Restores a state returned by GetBytes of an arena with the same layout, false if the size differs
+     */
+    bool SetBytes(std::span<const std::byte> bytes);
+    [[nodiscard]] std::size_t GetSize() const { return size_; }
+    [[nodiscard]] std::size_t GetCapacity() const { return capacity_; }
+    [[nodiscard]] MemoryUsage GetMemoryUsage() const { return { capacity_, size_ }; }
+private:
+    std::unique_ptr<std::byte[]> data_;
+    std::size_t capacity_ = 0;
+    std::size_t size_ = 0;
+};
+
+template <typename T>
+std::span<T> WorldArena::Allocate(std::size_t count)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "World arena state is copied with memcpy");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported by the world arena");
+    const auto offset = (size_ + alignof(T) - 1) / alignof(T) * alignof(T);
+    const auto end = offset + count * sizeof(T);
+    if (end > capacity_)
+    {
+        CORE_LOG_ERROR("[WorldArena] Allocating {} bytes at {} exceeds the capacity of {} bytes",
+            count * sizeof(T), offset, capacity_);
+        assert(false && "World arena capacity exceeded");
+        return {};
+    }
+    auto* values = reinterpret_cast<T*>(data_.get() + offset);
+    std::uninitialized_value_construct_n(values, count);
+    size_ = end;
+    return { values, count };
+}
+} // namespace core
@@ -3,6 +3,7 @@
 namespace sf
 {
 class RenderWindow;
+class RenderTarget;
 }
 
 namespace core
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include "sprite_batch.h"
+
+namespace core
+{
+    /**
+     * \brief Text of the HUD, the glyphs are only loaded when drawn
+     */
+    struct RenderText
+    {
+        const sf::Font* font = nullptr;
+        std::string text;
+        sf::Vector2f position{};
+        unsigned characterSize = 30;
+        sf::Color color = sf::Color::White;
+        /**
+         * \brief Position is the center of the text instead of its top left corner
+         */
+        bool centered = false;
+    };
+
+    /**
+     * \brief Everything needed to draw one frame, copied out of the systems so it can be drawn while they update.
+     * Sprites only reference their textures, the textures must outlive the snapshot and not change.
+     */
+    struct RenderSnapshot
+    {
+        sf::View worldView;
+        /**
+         * \brief Static drawables drawn in the world view behind the sprites, referenced like the textures
+         */
+        std::vector<const sf::Drawable*> backgrounds;
+        std::vector<sf::Sprite> sprites;
+        sf::View hudView;
+        std::vector<RenderText> texts;
+
+        /**
+         * \brief Keeps the storage of the vectors for the next frame
+         */
+        void Clear(const sf::View& defaultView);
+        void Draw(sf::RenderTarget& target, SpriteBatch& spriteBatch) const;
+    };
+
+    class RenderSnapshotInterface
+    {
+    public:
+        virtual ~RenderSnapshotInterface() = default;
+        virtual void WriteRenderSnapshot(RenderSnapshot& snapshot) = 0;
+    };
+}
@@ -5,6 +5,7 @@
 #include <SFML/Graphics/RenderWindow.hpp>
 
 #include "graphics.h"
+#include "sprite_batch.h"
 
 namespace core
 {
@@ -13,6 +14,9 @@ namespace core
     /**
      * \brief Manages sprites, order by greater entity index, background entity < foreground entity
      * Positions are centered at the center of the render target and use pixelPerMeter from globals.h
+     * Sprites are drawn through a SpriteBatch, one draw call per run of sprites sharing a texture
+     * Only the sprites of the dirty entities of the TransformManager are moved, the dirty entities are cleared by Draw
+     * and CopySprites
      */
     class SpriteManager :
         public ComponentManager<sf::Sprite, static_cast<Component>(ComponentType::SPRITE)>,
@@ -27,14 +31,29 @@ namespace core
         }
         void SetOrigin(Entity entity, sf::Vector2f origin);
         void SetTexture(Entity entity, const sf::Texture& texture);
-        void SetCenter(sf::Vector2f center) { center_ = center; }
-        void SetWindowSize(sf::Vector2f windowSize) { windowSize_ = windowSize; }
+        /**
+         * \brief Uses the textureRect part of texture, ex: a sub-rect of a TextureAtlas
+         */
+        void SetTexture(Entity entity, const sf::Texture& texture, const sf::IntRect& textureRect);
+        void AddComponent(Entity entity) override;
+        void SetCenter(sf::Vector2f center) { center_ = center; updateAllTransforms_ = true; }
+        void SetWindowSize(sf::Vector2f windowSize) { windowSize_ = windowSize; updateAllTransforms_ = true; }
         void Draw(sf::RenderTarget& window) override;
+        /**
+         * \brief Appends the sprites in drawing order, ex: to a RenderSnapshot drawn on another thread
+         */
+        void CopySprites(std::vector<sf::Sprite>& sprites);
         void SetColor(Entity entity, sf::Color color);
         void Flip(Entity entity);
+        [[nodiscard]] std::size_t GetDrawCallCount() const { return spriteBatch_.GetDrawCallCount(); }
         
     protected:
+        void UpdateTransforms();
+        void UpdateTransform(Entity entity);
+
         TransformManager& transformManager_;
+        SpriteBatch spriteBatch_;
+        bool updateAllTransforms_ = true;
         sf::Vector2f center_{};
         sf::Vector2f windowSize_{};
 
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+namespace core
+{
+    /**
+     * \brief Accumulates sprites into one vertex array of quads and draws consecutive sprites sharing a texture
+     * with a single draw call. The order of the added sprites is kept, so texture switches still cost a draw call.
+     * The vertex storage is reused between frames.
+     */
+    class SpriteBatch
+    {
+    public:
+        void Clear();
+        void Add(const sf::Sprite& sprite);
+        void Draw(sf::RenderTarget& target, sf::RenderStates states = sf::RenderStates::Default) const;
+        [[nodiscard]] std::size_t GetSpriteCount() const { return vertices_.size() / 4; }
+        [[nodiscard]] std::size_t GetDrawCallCount() const { return batches_.size(); }
+    private:
+        struct Batch
+        {
+            const sf::Texture* texture = nullptr;
+            std::size_t vertexStart = 0;
+            std::size_t vertexCount = 0;
+        };
+        std::vector<sf::Vertex> vertices_;
+        std::vector<Batch> batches_;
+    };
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+namespace core
+{
+    /**
+     * \brief Packs several images into one texture at load time, sprites then reference sub-rects of the atlas
+     * so they can be drawn in a single batch
+     */
+    class TextureAtlas
+    {
+    public:
+        /**
+         * \brief Adds an image to pack, referenced later by its name
+         */
+        bool AddImage(std::string_view name, const std::string& path);
+        /**
+         * \brief Adds all the png and jpg images of a directory, named by their file name (ex: "bullet.png")
+         */
+        bool AddDirectory(const std::string& path);
+        /**
+         * \brief Packs the added images in shelves sorted by height and uploads the atlas texture
+         */
+        bool Build();
+        /**
+         * \brief False until Build succeeded, headless clients never build their atlas
+         */
+        [[nodiscard]] bool IsBuilt() const { return built_; }
+        [[nodiscard]] const sf::Texture& GetTexture() const { return texture_; }
+        [[nodiscard]] sf::IntRect GetRect(std::string_view name) const;
+        /**
+         * \brief Transparent pixels between images so neighbours do not bleed when sampling at the borders
+         */
+        static constexpr unsigned padding = 1;
+    private:
+        struct Entry
+        {
+            std::string name;
+            sf::Image image;
+            sf::IntRect rect;
+        };
+        std::vector<Entry> entries_;
+        sf::Texture texture_;
+        bool built_ = false;
+    };
+}
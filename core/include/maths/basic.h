@@ -1,8 +1,11 @@
 #pragma once
 
 #include <cmath>
+#include <limits>
 #include <random>
 
+#include "maths/random.h"
+
 namespace core
 {
     inline float Abs(float v)
@@ -24,22 +27,19 @@ float Clamp(T value, T lower, T upper)
     return value < lower ? lower : (value > upper ? upper : value);
 }
 
+//RandomRange uses the generator of the calling thread, see GetThreadRng
 template<typename T>
 typename std::enable_if<std::is_integral<T>::value, T>::type RandomRange(T start, T end)
 {
-    static std::random_device rd;  //Will be used to obtain a seed for the random number engine
-    static std::mt19937 gen(rd()); //Standard mersenne_twister_engine seeded with rd()
     std::uniform_int_distribution<T> dis(start, end);
-    return dis(gen);
+    return dis(GetThreadRng());
 }
 
 template<typename T>
 typename std::enable_if<std::is_floating_point<T>::value, T>::type RandomRange(T start, T end)
 {
-    static std::random_device rd;  //Will be used to obtain a seed for the random number engine
-    static std::mt19937 gen(rd()); //Standard mersenne_twister_engine seeded with rd()
     std::uniform_real_distribution<T> dis(start, end);
-    return dis(gen);
+    return dis(GetThreadRng());
 }
 template<typename T>
 T constexpr SqrtNewtonRaphson(T x, T curr, T prev)
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+
+namespace core
+{
+
+/**
+ * \brief PCG32 generator (XSH RR variant), small, fast and fully determined by its seed and stream.
+ * Satisfies UniformRandomBitGenerator so it can be used with the std distributions too.
+ */
+class Rng
+{
+public:
+    using result_type = std::uint32_t;
+    static constexpr std::uint64_t defaultSeed = 0x853c49e6748fea9bull;
+    static constexpr std::uint64_t defaultStream = 0xda3e39cb94b95bdbull;
+
+    constexpr explicit Rng(std::uint64_t seed = defaultSeed, std::uint64_t stream = defaultStream)
+    {
+        Seed(seed, stream);
+    }
+
+    constexpr void Seed(std::uint64_t seed, std::uint64_t stream = defaultStream)
+    {
+        state_ = 0u;
+        increment_ = (stream << 1u) | 1u;
+        Next();
+        state_ += seed;
+        Next();
+    }
+
+    constexpr std::uint32_t Next()
+    {
+        const auto oldState = state_;
+        state_ = oldState * multiplier + increment_;
+        const auto xorShifted = static_cast<std::uint32_t>(((oldState >> 18u) ^ oldState) >> 27u);
+        const auto rotation = static_cast<std::uint32_t>(oldState >> 59u);
+        return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+    }
+
+    /**
+     * \brief Uniform integer in [0, bound), without modulo bias
+     */
+    constexpr std::uint32_t NextBounded(std::uint32_t bound)
+    {
+        //Lemire's multiply and reject method
+        auto product = static_cast<std::uint64_t>(Next()) * bound;
+        auto low = static_cast<std::uint32_t>(product);
+        if (low < bound)
+        {
+            const auto threshold = static_cast<std::uint32_t>(-bound) % bound;
+            while (low < threshold)
+            {
+                product = static_cast<std::uint64_t>(Next()) * bound;
+                low = static_cast<std::uint32_t>(product);
+            }
+        }
+        return static_cast<std::uint32_t>(product >> 32u);
+    }
+
+    /**
+     * \brief Uniform float in [0, 1), uses the 24 high bits so every value is exactly representable
+     */
+    constexpr float NextFloat()
+    {
+        return static_cast<float>(Next() >> 8u) * (1.0f / 16777216.0f);
+    }
+
+    constexpr float Range(float start, float end)
+    {
+        return start + (end - start) * NextFloat();
+    }
+
+    /**
+     * \brief Fills values with uniform floats in [start, end)
+     */
+    void Fill(std::span<float> values, float start, float end);
+
+    constexpr result_type operator()() { return Next(); }
+    static constexpr result_type min() { return 0u; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /**
+     * \brief State and stream of the generator, enough to restore it, ex: in a rollback
+     */
+    [[nodiscard]] constexpr std::uint64_t GetState() const { return state_; }
+    [[nodiscard]] constexpr std::uint64_t GetIncrement() const { return increment_; }
+    constexpr void SetState(std::uint64_t state, std::uint64_t increment)
+    {
+        state_ = state;
+        increment_ = increment | 1u;
+    }
+
+    constexpr bool operator==(const Rng& other) const = default;
+private:
+    static constexpr std::uint64_t multiplier = 6364136223846793005ull;
+    std::uint64_t state_ = 0u;
+    std::uint64_t increment_ = 0u;
+};
+
+/**
+ * \brief Generator of the calling thread, seeded from std::random_device, for the non deterministic uses
+ */
+Rng& GetThreadRng();
+
+}
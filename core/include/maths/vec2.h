@@ -1,11 +1,17 @@
 #pragma once
 
+#include <cmath>
+
 #include <SFML/System/Vector2.hpp>
 #include <maths/angle.h>
 
 namespace core
 {
 
+/**
+ * \brief 2d vector of floats, the operators are constexpr and inline so they vanish in the physics loops.
+ * See vec2_batch.h to process arrays of vectors at once.
+ */
 struct Vec2f
 {
     float x = 0.0f, y = 0.0f;
@@ -15,24 +21,49 @@ struct Vec2f
     {
 
     }
-    Vec2f(sf::Vector2f v);
+    Vec2f(sf::Vector2f v) : x(v.x), y(v.y)
+    {
+
+    }
 
 
-    [[nodiscard]] float GetMagnitude() const;
-    void Normalize();
-    [[nodiscard]] Vec2f GetNormalized() const;
-    [[nodiscard]] float GetSqrMagnitude() const;
-    [[nodiscard]] Vec2f Rotate(degree_t rotation) const;
-    static float Dot(Vec2f a, Vec2f b);
-    static Vec2f Lerp(Vec2f a, Vec2f b, float t);
-    [[nodiscard]] sf::Vector2f toSf() const;
+    [[nodiscard]] float GetMagnitude() const { return std::sqrt(GetSqrMagnitude()); }
+    void Normalize()
+    {
+        const auto magnitude = GetMagnitude();
+        x /= magnitude;
+        y /= magnitude;
+    }
+    [[nodiscard]] Vec2f GetNormalized() const { return (*this) / GetMagnitude(); }
+    [[nodiscard]] constexpr float GetSqrMagnitude() const { return x * x + y * y; }
+    [[nodiscard]] Vec2f Rotate(degree_t rotation) const
+    {
+        const auto cs = Cos(rotation);
+        const auto sn = Sin(rotation);
+        return { x * cs - y * sn, x * sn + y * cs };
+    }
+    static constexpr float Dot(Vec2f a, Vec2f b) { return a.x * b.x + a.y * b.y; }
+    static constexpr Vec2f Lerp(Vec2f a, Vec2f b, float t) { return a + (b - a) * t; }
+    [[nodiscard]] sf::Vector2f toSf() const { return sf::Vector2f(x, y); }
 
-    Vec2f operator+(Vec2f v) const;
-    Vec2f& operator+=(Vec2f v);
-    Vec2f operator-(Vec2f v) const;
-    Vec2f& operator-=(Vec2f v);
-    Vec2f operator*(float f) const;
-    Vec2f operator/(float f) const;
+    constexpr Vec2f operator+(Vec2f v) const { return { x + v.x, y + v.y }; }
+    constexpr Vec2f& operator+=(Vec2f v)
+    {
+        x += v.x;
+        y += v.y;
+        return *this;
+    }
+    constexpr Vec2f operator-(Vec2f v) const { return { x - v.x, y - v.y }; }
+    constexpr Vec2f& operator-=(Vec2f v)
+    {
+        x -= v.x;
+        y -= v.y;
+        return *this;
+    }
+    constexpr Vec2f operator-() const { return { -x, -y }; }
+    constexpr Vec2f operator*(float f) const { return { x * f, y * f }; }
+    constexpr Vec2f operator/(float f) const { return { x / f, y / f }; }
+    constexpr bool operator==(const Vec2f& v) const = default;
 
     static constexpr Vec2f zero() { return Vec2f(); }
     static constexpr Vec2f one() { return Vec2f(1,1); }
@@ -42,6 +73,11 @@ struct Vec2f
     static constexpr Vec2f right() { return Vec2f(1,0); }
 };
 
-Vec2f operator*(float f, Vec2f v);
+constexpr Vec2f operator*(float f, Vec2f v)
+{
+    return v * f;
+}
+
+static_assert(sizeof(Vec2f) == 2 * sizeof(float), "Vec2f arrays are processed as float arrays");
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "maths/vec2.h"
+
+#if !defined(CORE_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CORE_VEC2_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define CORE_VEC2_NEON
+#endif
+#endif
+
+namespace core
+{
+
+/**
+ * \brief Axis aligned box, stored as 4 contiguous floats so one box fits a SIMD register
+ */
+struct Aabb
+{
+    Vec2f min;
+    Vec2f max;
+
+    static constexpr Aabb FromCenter(Vec2f center, Vec2f extends) { return { center - extends, center + extends }; }
+    [[nodiscard]] constexpr bool Overlaps(const Aabb& other) const
+    {
+        return min.x <= other.max.x && other.min.x <= max.x &&
+            min.y <= other.max.y && other.min.y <= max.y;
+    }
+};
+static_assert(sizeof(Aabb) == 4 * sizeof(float), "Aabb is loaded as 4 floats");
+
+/**
+ * Batch kernels on arrays of vectors, with SSE2 or NEON backends when available (CORE_NO_SIMD forces the scalar
+ * ones). The spans of a call must have the same size, the output may alias an input of the same type.
+ */
+
+/**
+ * \brief positions[i] += velocities[i] * dt
+ */
+void Integrate(std::span<Vec2f> positions, std::span<const Vec2f> velocities, float dt);
+/**
+ * \brief result[i] = vectors[i] * scale + offset
+ */
+void ScaleAndOffset(std::span<const Vec2f> vectors, Vec2f scale, Vec2f offset, std::span<Vec2f> result);
+/**
+ * \brief result[i] = Dot(a[i], b[i])
+ */
+void Dot(std::span<const Vec2f> a, std::span<const Vec2f> b, std::span<float> result);
+/**
+ * \brief overlaps[i] = box.Overlaps(boxes[i]), returns the number of overlapping boxes
+ */
+std::size_t Overlaps(const Aabb& box, std::span<const Aabb> boxes, std::span<std::uint8_t> overlaps);
+
+}
@@ -22,12 +22,68 @@
  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  SOFTWARE.
  */
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
-#include <functional>
 
 namespace core
 {
 
+/**
+ * \brief Non-owning, non-allocating callable: a function pointer and a small inline buffer.
+ * Only small trivially copyable callables fit, ex: lambdas capturing a few references or pointers.
+ */
+template<class ... Ts>
+class Delegate
+{
+public:
+    static constexpr std::size_t storageSize = 2 * sizeof(void*);
+
+    Delegate() = default;
+
+    template<class F>
+        requires (!std::is_same_v<std::decay_t<F>, Delegate> && std::is_invocable_v<const std::decay_t<F>&, Ts...>)
+    Delegate(F&& callable)
+    {
+        using Callable = std::decay_t<F>;
+        static_assert(sizeof(Callable) <= storageSize && alignof(Callable) <= alignof(void*),
+            "Callable does not fit in the delegate storage");
+        static_assert(std::is_trivially_copyable_v<Callable> && std::is_trivially_destructible_v<Callable>,
+            "Delegate storage is copied as raw bytes");
+        ::new (static_cast<void*>(storage_)) Callable(std::forward<F>(callable));
+        function_ = [](const void* storage, Ts ... args)
+        {
+            (*std::launder(static_cast<const Callable*>(storage)))(args...);
+        };
+    }
+
+    /**
+     * \brief Calls Method on instance, the instance has to outlive the delegate
+     */
+    template<auto Method, class T>
+    static Delegate Bind(T& instance)
+    {
+        return Delegate([&instance](Ts ... args) { (instance.*Method)(args...); });
+    }
+
+    void operator()(Ts ... args) const
+    {
+        function_(storage_, args...);
+    }
+
+    explicit operator bool() const { return function_ != nullptr; }
+
+private:
+    using Function = void(*)(const void*, Ts...);
+    alignas(void*) std::byte storage_[storageSize]{};
+    Function function_ = nullptr;
+};
+
+/**
+ * \brief List of callbacks called in registration order, registering is the only allocation
+ */
 template<class ... Ts>
 class Action
 {
@@ -35,21 +91,20 @@ public:
     Action() = default;
     virtual ~Action() =  default ;
 
-    void RegisterCallback(const std::function<void(Ts ...)>& callback)
+    void RegisterCallback(const Delegate<Ts...>& callback)
     {
-	callbacks_.push_back(callback);
-	    
+        callbacks_.push_back(callback);
     }
 
-    void Execute(Ts ... args)
+    void Execute(Ts ... args) const
     {
-	for(auto& callback : callbacks_)
-	{
-	    callback(args...);
-	}
+        for(const auto& callback : callbacks_)
+        {
+            callback(args...);
+        }
     }
 
 private:
-	std::vector<std::function<void(Ts...)>> callbacks_;
+    std::vector<Delegate<Ts...>> callbacks_;
 };
 }
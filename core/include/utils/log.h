@@ -1,13 +1,66 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
 
+#include <fmt/format.h>
+
+/**
+ * \brief Levels below CORE_LOG_LEVEL are compiled out of the CORE_LOG macros: 0 debug, 1 warning, 2 error, 3 none
+ */
+#ifndef CORE_LOG_LEVEL
+#define CORE_LOG_LEVEL 0
+#endif
+
 namespace core
 {
 
+enum class LogLevel : std::uint8_t
+{
+    Debug = 0,
+    Warning = 1,
+    Error = 2,
+    None = 3
+};
+
+constexpr LogLevel compiledLogLevel = static_cast<LogLevel>(CORE_LOG_LEVEL);
+
+/**
+ * \brief Runtime filter, the messages below level are dropped before being formatted by the CORE_LOG macros
+ */
+void SetLogLevel(LogLevel level);
+[[nodiscard]] bool IsLogEnabled(LogLevel level);
+/**
+ * \brief Moves the writing of the logs to a background thread, queueSize messages are kept before blocking the caller
+ */
+void InitAsyncLogging(std::size_t queueSize = 8192);
+/**
+ * \brief Flushes the pending logs, to call before exiting when the async logging is used
+ */
+void ShutdownLogging();
+
 void LogDebug(std::string_view msg);
 
 void LogWarning(std::string_view msg);
 
 void LogError(std::string_view msg);
-}
\ No newline at end of file
+}
+
+/**
+ * Format string logging, the arguments are only formatted if the level is compiled in and enabled at runtime
+ */
+#define CORE_LOG(level, logFunction, ...) \
+    do \
+    { \
+        if constexpr ((level) >= ::core::compiledLogLevel) \
+        { \
+            if (::core::IsLogEnabled(level)) \
+            { \
+                logFunction(fmt::format(__VA_ARGS__)); \
+            } \
+        } \
+    } while (false)
+#define CORE_LOG_DEBUG(...) CORE_LOG(::core::LogLevel::Debug, ::core::LogDebug, __VA_ARGS__)
+#define CORE_LOG_WARNING(...) CORE_LOG(::core::LogLevel::Warning, ::core::LogWarning, __VA_ARGS__)
+#define CORE_LOG_ERROR(...) CORE_LOG(::core::LogLevel::Error, ::core::LogError, __VA_ARGS__)
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace core
+{
+
+/**
+ * \brief Read-only memory mapping of a whole file, the pages are loaded by the OS when accessed
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+    [[nodiscard]] bool IsOpen() const { return data_ != nullptr; }
+    [[nodiscard]] const std::uint8_t* GetData() const { return data_; }
+    [[nodiscard]] std::size_t GetSize() const { return size_; }
+private:
+    const std::uint8_t* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    void* fileHandle_ = nullptr;
+    void* mappingHandle_ = nullptr;
+#endif
+};
+
+} // namespace core
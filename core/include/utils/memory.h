@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core
+{
+
+/**
+ * \brief Subsystem the allocations of a thread are accounted to, set with MemoryTagScope
+ */
+enum class MemoryTag : std::uint8_t
+{
+    Untagged = 0,
+    Entities,
+    Components,
+    Rollback,
+    Replay,
+    Network,
+    Graphics,
+    Length
+};
+
+struct MemoryTagStats
+{
+    std::size_t currentBytes = 0;
+    std::size_t peakBytes = 0;
+    std::uint64_t allocationCount = 0;
+};
+
+[[nodiscard]] const char* GetMemoryTagName(MemoryTag tag);
+/**
+ * \brief The global allocation hook is only compiled with ENABLE_MEMORY_TRACKING, the tag stats stay empty otherwise
+ */
+[[nodiscard]] bool IsMemoryTrackingEnabled();
+[[nodiscard]] MemoryTagStats GetMemoryTagStats(MemoryTag tag);
+[[nodiscard]] MemoryTag GetCurrentMemoryTag();
+
+/**
+ * \brief Accounts the allocations of the calling thread to tag until the end of the scope
+ */
+class MemoryTagScope
+{
+public:
+    explicit MemoryTagScope(MemoryTag tag);
+    ~MemoryTagScope();
+    MemoryTagScope(const MemoryTagScope&) = delete;
+    MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+private:
+    MemoryTag previousTag_;
+};
+
+/**
+ * \brief Bytes reserved by a container compared to the bytes of its live elements
+ */
+struct MemoryUsage
+{
+    std::size_t capacityBytes = 0;
+    std::size_t liveBytes = 0;
+
+    MemoryUsage& operator+=(const MemoryUsage& other)
+    {
+        capacityBytes += other.capacityBytes;
+        liveBytes += other.liveBytes;
+        return *this;
+    }
+};
+
+template<typename T>
+[[nodiscard]] MemoryUsage GetMemoryUsage(const std::vector<T>& values, std::size_t liveCount)
+{
+    return { values.capacity() * sizeof(T), liveCount * sizeof(T) };
+}
+
+template<typename T>
+[[nodiscard]] MemoryUsage GetMemoryUsage(const std::vector<T>& values)
+{
+    return GetMemoryUsage(values, values.size());
+}
+
+struct MemoryReportEntry
+{
+    std::string subsystem;
+    std::string name;
+    MemoryUsage usage;
+};
+
+/**
+ * \brief Breakdown of the memory of the managers by subsystem, filled by their owners
+ */
+class MemoryReport
+{
+public:
+    void Add(std::string_view subsystem, std::string_view name, MemoryUsage usage);
+    void Clear() { entries_.clear(); }
+    [[nodiscard]] const std::vector<MemoryReportEntry>& GetEntries() const { return entries_; }
+    [[nodiscard]] MemoryUsage GetTotal() const;
+    [[nodiscard]] MemoryUsage GetSubsystemTotal(std::string_view subsystem) const;
+    /**
+     * \brief Logs the subsystem totals, the entries and the tag stats
+     */
+    void Log() const;
+    void DrawImGui() const;
+private:
+    std::vector<MemoryReportEntry> entries_;
+};
+
+}
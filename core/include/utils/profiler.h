@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "graphics/graphics.h"
+
+namespace core
+{
+
+/**
+ * \brief Finished zone, timestamps in nanoseconds since the creation of the profiler
+ */
+struct ProfileEvent
+{
+    const char* name = nullptr;
+    std::int64_t startNs = 0;
+    std::int64_t endNs = 0;
+    std::uint32_t threadIndex = 0;
+    std::uint32_t depth = 0;
+};
+
+/**
+ * \brief Collects the zones of all threads. Each thread writes in its own ring buffer without locking,
+ * only the last ringSize zones of a thread are kept.
+ * The ImGui panel shows the timeline of the last frame marked with MarkFrame, WriteChromeTrace dumps all the
+ * kept zones for chrome://tracing or Perfetto.
+ */
+class Profiler : public DrawImGuiInterface
+{
+public:
+    static Profiler& Get();
+    [[nodiscard]] std::int64_t GetTimeNs() const;
+    void SetEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    [[nodiscard]] bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+    /**
+     * \brief Stores a finished zone in the ring buffer of the calling thread
+     */
+    void Record(const char* name, std::int64_t startNs, std::int64_t endNs, std::uint32_t depth);
+    /**
+     * \brief Starts a new frame, to call from the thread driving the frames
+     */
+    void MarkFrame();
+    /**
+     * \brief Appends the kept zones of all threads overlapping [startNs, endNs)
+     */
+    void CollectEvents(std::vector<ProfileEvent>& events, std::int64_t startNs, std::int64_t endNs) const;
+    bool WriteChromeTrace(const std::string& path) const;
+    void DrawImGui() override;
+
+    static constexpr std::size_t ringSize = 1u << 16u;
+private:
+    struct ThreadBuffer
+    {
+        std::uint32_t threadIndex = 0;
+        std::atomic<std::uint64_t> writeIndex{ 0 };
+        std::array<ProfileEvent, ringSize> events{};
+    };
+    Profiler();
+    ThreadBuffer& GetThreadBuffer();
+
+    const std::int64_t creationTimeNs_;
+    std::atomic<bool> enabled_{ true };
+    mutable std::mutex buffersMutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    std::atomic<std::int64_t> frameStartNs_{ 0 };
+    std::atomic<std::int64_t> lastFrameStartNs_{ 0 };
+    std::atomic<std::int64_t> lastFrameEndNs_{ 0 };
+
+    std::vector<ProfileEvent> timelineEvents_;
+    bool timelinePaused_ = false;
+};
+
+/**
+ * \brief Records the time between its construction and its destruction, use CORE_PROFILE_ZONE
+ */
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char* name);
+    ~ProfileZone();
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+private:
+    const char* name_ = nullptr;
+    std::int64_t startNs_ = 0;
+    std::uint32_t depth_ = 0;
+};
+
+}
+
+/**
+ * \brief Profiles the rest of the scope, name must be a string literal. CORE_NO_PROFILER compiles the zones out.
+ */
+#ifdef CORE_NO_PROFILER
+#define CORE_PROFILE_ZONE(name)
+#else
+#define CORE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CORE_PROFILE_CONCAT(a, b) CORE_PROFILE_CONCAT_IMPL(a, b)
+#define CORE_PROFILE_ZONE(name) const ::core::ProfileZone CORE_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace core
+{
+
+/**
+ * \brief Lock-free single producer single consumer exchange of whole values.
+ * The producer writes in its own buffer and publishes it, the consumer fetches the last published buffer,
+ * so neither side ever waits for the other and unread values are simply overwritten.
+ * The buffers are reused, T should keep its storage when cleared.
+ */
+template<typename T>
+class TripleBuffer
+{
+public:
+    [[nodiscard]] T& GetWriteBuffer() { return buffers_[writeIndex_]; }
+    /**
+     * \brief Gives the write buffer to the consumer and takes back the unused buffer for the next write
+     */
+    void Publish()
+    {
+        writeIndex_ = static_cast<std::uint8_t>(
+            shared_.exchange(writeIndex_ | newDataBit, std::memory_order_acq_rel) & indexMask);
+    }
+    /**
+     * \brief Takes the last published buffer, returns false and keeps the current read buffer if nothing new
+     * was published
+     */
+    bool Fetch()
+    {
+        if ((shared_.load(std::memory_order_relaxed) & newDataBit) == 0)
+        {
+            return false;
+        }
+        readIndex_ = static_cast<std::uint8_t>(
+            shared_.exchange(readIndex_, std::memory_order_acq_rel) & indexMask);
+        return true;
+    }
+    [[nodiscard]] const T& GetReadBuffer() const { return buffers_[readIndex_]; }
+private:
+    static constexpr std::uint8_t newDataBit = 1u << 2u;
+    static constexpr std::uint8_t indexMask = newDataBit - 1u;
+
+    std::array<T, 3> buffers_{};
+    std::uint8_t writeIndex_ = 0;
+    /**
+     * \brief Index of the buffer in between the producer and the consumer, with newDataBit set when published
+     */
+    std::atomic<std::uint8_t> shared_{ 1 };
+    std::uint8_t readIndex_ = 2;
+};
+
+}
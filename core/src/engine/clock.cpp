@@ -0,0 +1,34 @@
+#include <engine/clock.h>
+
+#include <chrono>
+
+namespace core
+{
+unsigned long long SystemClock::GetTimeMs() const
+{
+    using namespace std::chrono;
+    return duration_cast<duration<unsigned long long, std::milli>>(
+        system_clock::now().time_since_epoch()).count();
+}
+
+const SystemClock& SystemClock::Get()
+{
+    static const SystemClock systemClock;
+    return systemClock;
+}
+
+ManualClock::ManualClock(unsigned long long startTimeMs) :
+    currentTimeUs_(static_cast<std::int64_t>(startTimeMs) * 1000)
+{
+}
+
+void ManualClock::Advance(sf::Time dt)
+{
+    currentTimeUs_ += dt.asMicroseconds();
+}
+
+unsigned long long ManualClock::GetTimeMs() const
+{
+    return static_cast<unsigned long long>(currentTimeUs_ / 1000);
+}
+} // namespace core
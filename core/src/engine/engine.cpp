@@ -1,9 +1,14 @@
 #include <engine/engine.h>
 
+#include <thread>
+
+#include <SFML/System/Sleep.hpp>
 #include <SFML/Window/Event.hpp>
 
 #include "engine/system.h"
 #include "graphics/graphics.h"
+#include "utils/memory.h"
+#include "utils/profiler.h"
 
 #include <imgui.h>
 #include <imgui-SFML.h>
@@ -15,11 +20,20 @@ namespace core
 void Engine::Run()
 {
     Init();
-    sf::Clock clock;
-    while (window_->isOpen())
+    if (threadedRendering_)
     {
-        const auto dt = clock.restart();
-        Update(dt);
+        RunThreaded();
+    }
+    else
+    {
+        framePacer_.BeginFrame();
+        while (window_->isOpen())
+        {
+            const auto dt = framePacer_.BeginFrame();
+            Profiler::Get().MarkFrame();
+            Update(dt);
+            framePacer_.EndFrame();
+        }
     }
     Destroy();
 }
@@ -44,9 +58,21 @@ void Engine::RegisterDrawImGui(DrawImGuiInterface* drawImGuiInterface)
     drawImGuiInterfaces_.push_back(drawImGuiInterface);
 }
 
+void Engine::RegisterRenderImGui(DrawImGuiInterface* drawImGuiInterface)
+{
+    renderImGuiInterfaces_.push_back(drawImGuiInterface);
+}
+
+void Engine::RegisterRenderSnapshot(RenderSnapshotInterface* renderSnapshotInterface)
+{
+    renderSnapshotInterfaces_.push_back(renderSnapshotInterface);
+}
+
 void Engine::Init()
 {
     window_ = std::make_unique<sf::RenderWindow>(sf::VideoMode(windowSize.x, windowSize.y), "Pong Rollback Game");
+    windowView_ = window_->getDefaultView();
+    window_->setVerticalSyncEnabled(verticalSync_);
     ImGui::SFML::Init(*window_);
     for(auto& system : systems_)
     {
@@ -55,6 +81,45 @@ void Engine::Init()
 }
 
 void Engine::Update(sf::Time dt)
+{
+    PollEvents();
+    ApplyVerticalSync();
+    {
+        CORE_PROFILE_ZONE("Engine::Systems");
+        for (auto* system : systems_)
+        {
+            system->Update(dt);
+        }
+    }
+    ImGui::SFML::Update(*window_, dt);
+    window_->clear(sf::Color::Black);
+
+    {
+        CORE_PROFILE_ZONE("Engine::Draw");
+        const MemoryTagScope memoryTagScope(MemoryTag::Graphics);
+        for (auto* drawInterface : drawInterfaces_)
+        {
+            drawInterface->Draw(*window_);
+        }
+    }
+    {
+        CORE_PROFILE_ZONE("Engine::DrawImGui");
+        for (auto* drawImGuiInterface : renderImGuiInterfaces_)
+        {
+            drawImGuiInterface->DrawImGui();
+        }
+        for (auto* drawImGuiInterface : drawImGuiInterfaces_)
+        {
+            drawImGuiInterface->DrawImGui();
+        }
+        ImGui::SFML::Render(*window_);
+    }
+
+    CORE_PROFILE_ZONE("Engine::Display");
+    window_->display();
+}
+
+void Engine::PollEvents()
 {
     sf::Event e{};
     while (window_->pollEvent(e))
@@ -74,29 +139,126 @@ void Engine::Update(sf::Time dt)
         default:
             break;
         }
-        for(auto* eventInterface : eventInterfaces_)
+        if (threadedRendering_)
         {
-            eventInterface->OnEvent(e);
+            //The event interfaces belong to the simulation thread
+            std::scoped_lock lock(eventMutex_);
+            pendingEvents_.push_back(e);
+        }
+        else
+        {
+            for(auto* eventInterface : eventInterfaces_)
+            {
+                eventInterface->OnEvent(e);
+            }
         }
     }
-    for(auto* system : systems_)
+}
+
+void Engine::ApplyVerticalSync()
+{
+    if (framePacer_.IsVerticalSyncEnabled() != verticalSync_)
     {
-        system->Update(dt);
+        verticalSync_ = framePacer_.IsVerticalSyncEnabled();
+        window_->setVerticalSyncEnabled(verticalSync_);
     }
-    ImGui::SFML::Update(*window_, dt);
-    window_->clear(sf::Color::Black);
+}
 
-    for(auto* drawInterface : drawInterfaces_)
+void Engine::RunThreaded()
+{
+    isRunning_ = true;
+    std::thread simulationThread(&Engine::SimulationLoop, this);
+    framePacer_.BeginFrame();
+    while (window_->isOpen())
     {
-        drawInterface->Draw(*window_);
+        const auto dt = framePacer_.BeginFrame();
+        Profiler::Get().MarkFrame();
+        PollEvents();
+        ApplyVerticalSync();
+        ImGui::SFML::Update(*window_, dt);
+        window_->clear(sf::Color::Black);
+
+        {
+            CORE_PROFILE_ZONE("Engine::DrawSnapshot");
+            const MemoryTagScope memoryTagScope(MemoryTag::Graphics);
+            renderSnapshots_.Fetch();
+            renderSnapshots_.GetReadBuffer().Draw(*window_, spriteBatch_);
+        }
+        {
+            CORE_PROFILE_ZONE("Engine::DrawImGui");
+            for (auto* drawImGuiInterface : renderImGuiInterfaces_)
+            {
+                drawImGuiInterface->DrawImGui();
+            }
+            //These windows read the systems directly, skipping them during long updates would hide them and drop
+            //their inputs exactly when they are needed
+            if (!drawImGuiInterfaces_.empty())
+            {
+                std::scoped_lock lock(simulationMutex_);
+                for (auto* drawImGuiInterface : drawImGuiInterfaces_)
+                {
+                    drawImGuiInterface->DrawImGui();
+                }
+            }
+        }
+        ImGui::SFML::Render(*window_);
+
+        {
+            CORE_PROFILE_ZONE("Engine::Display");
+            window_->display();
+        }
+        framePacer_.EndFrame();
     }
-    for(auto* drawImGuiInterface : drawImGuiInterfaces_)
+    isRunning_ = false;
+    simulationThread.join();
+}
+
+void Engine::SimulationLoop()
+{
+    sf::Clock clock;
+    std::vector<sf::Event> events;
+    while (isRunning_)
     {
-        drawImGuiInterface->DrawImGui();
+        const auto dt = clock.restart();
+        {
+            std::scoped_lock lock(eventMutex_);
+            events.swap(pendingEvents_);
+        }
+        {
+            std::scoped_lock lock(simulationMutex_);
+            CORE_PROFILE_ZONE("Engine::Simulation");
+            for (const auto& e : events)
+            {
+                if (e.type == sf::Event::Resized)
+                {
+                    windowView_ = sf::View(sf::FloatRect(0, 0, e.size.width, e.size.height));
+                }
+                for (auto* eventInterface : eventInterfaces_)
+                {
+                    eventInterface->OnEvent(e);
+                }
+            }
+            events.clear();
+            for (auto* system : systems_)
+            {
+                system->Update(dt);
+            }
+            const MemoryTagScope memoryTagScope(MemoryTag::Graphics);
+            auto& snapshot = renderSnapshots_.GetWriteBuffer();
+            snapshot.Clear(windowView_);
+            for (auto* renderSnapshotInterface : renderSnapshotInterfaces_)
+            {
+                renderSnapshotInterface->WriteRenderSnapshot(snapshot);
+            }
+            renderSnapshots_.Publish();
+        }
+        //Leave the systems to the ImGui windows of the main thread until the next update
+        const auto remainingTime = sf::seconds(simulationPeriod) - clock.getElapsedTime();
+        if (remainingTime > sf::Time::Zero)
+        {
+            sf::sleep(remainingTime);
+        }
     }
-    ImGui::SFML::Render(*window_);
-
-    window_->display();
 }
 
 void Engine::Destroy()
@@ -1,5 +1,8 @@
 #include <engine/entity.h>
 
+#include <algorithm>
+#include <cassert>
+
 #include "engine/component.h"
 
 namespace core
@@ -25,7 +28,15 @@ Entity EntityManager::CreateEntity()
     if (entityMaskIt == entityMasks_.end())
     {
         const auto newEntity = entityMasks_.size();
-        entityMasks_.resize(newEntity + newEntity / 2, INVALID_ENTITY_MASK);
+        if (capacityFixed_)
+        {
+            CORE_LOG_ERROR("[Entity] Cannot create more than {} entities, raise the world capacity", newEntity);
+            return INVALID_ENTITY;
+        }
+        const auto newSize = GetGrownCapacity(newEntity, newEntity + 1);
+        CheckGrowth("entities", newSize);
+        const MemoryTagScope memoryTagScope(MemoryTag::Entities);
+        entityMasks_.resize(newSize, INVALID_ENTITY_MASK);
         AddComponent(
             static_cast<Entity>(newEntity),
             static_cast<EntityMask>(ComponentType::EMPTY));
@@ -69,4 +80,21 @@ bool EntityManager::HasComponent(Entity entity, EntityMask mask) const
 {
     return (entityMasks_[entity] & mask) == mask;
 }
+
+void EntityManager::CheckGrowth(std::string_view arrayName, std::size_t newSize) const
+{
+    if (capacityLocked_)
+    {
+        CORE_LOG_ERROR("[Entity] Growing the {} from {} to {} while the capacity is locked",
+            arrayName, entityMasks_.size(), newSize);
+        assert(false && "Entity capacity is locked, raise the world capacity");
+    }
+}
+
+MemoryUsage EntityManager::GetMemoryUsage() const
+{
+    const auto liveCount = std::count_if(entityMasks_.begin(), entityMasks_.end(),
+        [](EntityMask entityMask) { return entityMask != INVALID_ENTITY_MASK; });
+    return core::GetMemoryUsage(entityMasks_, static_cast<std::size_t>(liveCount));
+}
 }
@@ -0,0 +1,106 @@
+#include <engine/frame_pacer.h>
+
+#include <algorithm>
+#include <thread>
+
+#include <SFML/System/Sleep.hpp>
+
+#include <imgui.h>
+
+namespace core
+{
+sf::Time FramePacer::BeginFrame()
+{
+    const auto now = clock_.getElapsedTime();
+    const auto frameTime = now - frameStart_;
+    frameStart_ = now;
+    UpdateStats(frameTime, lastWorkTime_, lastWaitError_);
+    return frameTime;
+}
+
+void FramePacer::EndFrame()
+{
+    const auto workEnd = clock_.getElapsedTime();
+    lastWorkTime_ = workEnd - frameStart_;
+    lastWaitError_ = sf::Time::Zero;
+    if (targetFrameRate_ <= 0.0f)
+    {
+        return;
+    }
+    const auto framePeriod = sf::seconds(1.0f / targetFrameRate_);
+    nextFrameDeadline_ += framePeriod;
+    //After a long frame, start again from now instead of rushing the next frames to catch up
+    if (nextFrameDeadline_ < workEnd)
+    {
+        nextFrameDeadline_ = workEnd;
+        return;
+    }
+    const auto sleepTime = nextFrameDeadline_ - workEnd - spinTime_;
+    if (sleepTime > sf::Time::Zero)
+    {
+        sf::sleep(sleepTime);
+        UpdateSpinTime(clock_.getElapsedTime() - workEnd - sleepTime);
+    }
+    while (clock_.getElapsedTime() < nextFrameDeadline_)
+    {
+        std::this_thread::yield();
+    }
+    lastWaitError_ = clock_.getElapsedTime() - nextFrameDeadline_;
+}
+
+void FramePacer::SetSpinTimeRange(sf::Time minSpinTime, sf::Time maxSpinTime)
+{
+    minSpinTime_ = minSpinTime;
+    maxSpinTime_ = std::max(minSpinTime, maxSpinTime);
+    spinTime_ = std::clamp(spinTime_, minSpinTime_, maxSpinTime_);
+}
+
+void FramePacer::UpdateSpinTime(sf::Time oversleep)
+{
+    sleepOvershoot_ = std::max(oversleep, sleepOvershoot_ * overshootDecay);
+    spinTime_ = std::clamp(sleepOvershoot_ + sf::microseconds(spinMarginMicroseconds), minSpinTime_, maxSpinTime_);
+}
+
+void FramePacer::UpdateStats(sf::Time frameTime, sf::Time workTime, sf::Time waitError)
+{
+    statsFrameCount_++;
+    frameTimeSum_ += frameTime;
+    workTimeSum_ += workTime;
+    waitErrorSum_ += waitError;
+    maxFrameTime_ = std::max(maxFrameTime_, frameTime);
+
+    const auto statsDuration = frameStart_ - statsStart_;
+    if (statsDuration < sf::seconds(1.0f))
+    {
+        return;
+    }
+    const auto frameCount = static_cast<sf::Int64>(statsFrameCount_);
+    stats_.framesPerSecond = static_cast<float>(statsFrameCount_) / statsDuration.asSeconds();
+    stats_.averageFrameTime = sf::microseconds(frameTimeSum_.asMicroseconds() / frameCount);
+    stats_.maxFrameTime = maxFrameTime_;
+    stats_.averageWorkTime = sf::microseconds(workTimeSum_.asMicroseconds() / frameCount);
+    stats_.averageWaitError = sf::microseconds(waitErrorSum_.asMicroseconds() / frameCount);
+    stats_.spinTime = spinTime_;
+
+    statsStart_ = frameStart_;
+    statsFrameCount_ = 0;
+    frameTimeSum_ = sf::Time::Zero;
+    maxFrameTime_ = sf::Time::Zero;
+    workTimeSum_ = sf::Time::Zero;
+    waitErrorSum_ = sf::Time::Zero;
+}
+
+void FramePacer::DrawImGui()
+{
+    ImGui::Begin("Frame pacing");
+    ImGui::SliderFloat("Target FPS (0 uncapped)", &targetFrameRate_, 0.0f, 240.0f, "%.0f");
+    ImGui::Checkbox("VSync", &verticalSync_);
+    ImGui::Text("FPS: %.1f", stats_.framesPerSecond);
+    ImGui::Text("Frame time: avg %.2f ms, max %.2f ms",
+        stats_.averageFrameTime.asSeconds() * 1000.0f, stats_.maxFrameTime.asSeconds() * 1000.0f);
+    ImGui::Text("Work time: avg %.2f ms", stats_.averageWorkTime.asSeconds() * 1000.0f);
+    ImGui::Text("Wait error: avg %.3f ms", stats_.averageWaitError.asSeconds() * 1000.0f);
+    ImGui::Text("Spin time: %.3f ms", stats_.spinTime.asSeconds() * 1000.0f);
+    ImGui::End();
+}
+} // namespace core
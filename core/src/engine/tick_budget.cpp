@@ -0,0 +1,94 @@
+#include <engine/tick_budget.h>
+
+#include <algorithm>
+
+#include <imgui.h>
+
+#include "utils/log.h"
+
+namespace core
+{
+
+TickBudgetTracker::SystemId TickBudgetTracker::AddSystem(const char* name, sf::Time budget)
+{
+    TickBudgetStats stats;
+    stats.name = name;
+    stats.budget = budget;
+    stats_.push_back(stats);
+    return stats_.size() - 1;
+}
+
+void TickBudgetTracker::Record(SystemId systemId, sf::Time tickTime)
+{
+    auto& stats = stats_[systemId];
+    stats.lastTime = tickTime;
+    stats.maxTime = std::max(stats.maxTime, tickTime);
+    stats.totalTime += tickTime;
+    stats.tickCount++;
+    stats.currentWindowMaxTime = std::max(stats.currentWindowMaxTime, tickTime);
+    if (tickTime > stats.budget)
+    {
+        stats.overrunCount++;
+        stats.currentWindowOverrunCount++;
+    }
+}
+
+void TickBudgetTracker::Update()
+{
+    if (windowClock_.getElapsedTime() < sf::seconds(overrunWindow))
+    {
+        return;
+    }
+    windowClock_.restart();
+    for (auto& stats : stats_)
+    {
+        if (logOverruns_ && stats.currentWindowOverrunCount > 0)
+        {
+            CORE_LOG_WARNING("[Tick budget] {} overran {} times in the last {}s, worst tick {} us for a budget of {} us",
+                stats.name, stats.currentWindowOverrunCount, overrunWindow,
+                stats.currentWindowMaxTime.asMicroseconds(), stats.budget.asMicroseconds());
+        }
+        stats.windowOverrunCount = stats.currentWindowOverrunCount;
+        stats.windowMaxTime = stats.currentWindowMaxTime;
+        stats.currentWindowOverrunCount = 0;
+        stats.currentWindowMaxTime = sf::Time::Zero;
+    }
+}
+
+void TickBudgetTracker::Reset()
+{
+    for (auto& stats : stats_)
+    {
+        TickBudgetStats resetStats;
+        resetStats.name = stats.name;
+        resetStats.budget = stats.budget;
+        stats = resetStats;
+    }
+    windowClock_.restart();
+}
+
+void TickBudgetTracker::DrawImGui()
+{
+    if (!ImGui::CollapsingHeader("Tick budget"))
+    {
+        return;
+    }
+    ImGui::Checkbox("Log overruns", &logOverruns_);
+    for (const auto& stats : stats_)
+    {
+        const auto average = stats.tickCount == 0 ?
+            sf::Time::Zero : stats.totalTime / static_cast<sf::Int64>(stats.tickCount);
+        ImGui::Text("%s: avg %lld us, max %lld us, budget %lld us", stats.name,
+            static_cast<long long>(average.asMicroseconds()),
+            static_cast<long long>(stats.maxTime.asMicroseconds()),
+            static_cast<long long>(stats.budget.asMicroseconds()));
+        ImGui::Text("    overruns: %u in the last %.0fs, %llu total", stats.windowOverrunCount, overrunWindow,
+            static_cast<unsigned long long>(stats.overrunCount));
+    }
+    if (ImGui::Button("Reset tick budget"))
+    {
+        Reset();
+    }
+}
+
+} // namespace core
@@ -2,6 +2,8 @@
 
 #include <engine/transform.h>
 
+#include <algorithm>
+
 namespace core
 {
 void ScaleManager::AddComponent(Entity entity)
@@ -23,24 +25,30 @@ Vec2f TransformManager::GetPosition(Entity entity) const
     return positionManager_.GetComponent(entity);
 }
 
-const std::vector<Vec2f>& TransformManager::GetAllPositions() const
+std::span<const Vec2f> TransformManager::GetAllPositions() const
 {
     return positionManager_.GetAllComponents();
 }
 
-const std::vector<Vec2f>& TransformManager::GetAllScales() const
+std::span<const Vec2f> TransformManager::GetAllScales() const
 {
     return scaleManager_.GetAllComponents();
 }
 
-const std::vector<degree_t>& TransformManager::GetAllRotations() const
+std::span<const degree_t> TransformManager::GetAllRotations() const
 {
     return rotationManager_.GetAllComponents();
 }
 
 void TransformManager::SetPosition(Entity entity, Vec2f position)
 {
+    const auto& currentPosition = positionManager_.GetComponent(entity);
+    if (currentPosition.x == position.x && currentPosition.y == position.y)
+    {
+        return;
+    }
     positionManager_.SetComponent(entity, position);
+    MarkDirty(entity);
 }
 
 Vec2f TransformManager::GetScale(Entity entity) const
@@ -50,7 +58,13 @@ Vec2f TransformManager::GetScale(Entity entity) const
 
 void TransformManager::SetScale(Entity entity, Vec2f scale)
 {
+    const auto& currentScale = scaleManager_.GetComponent(entity);
+    if (currentScale.x == scale.x && currentScale.y == scale.y)
+    {
+        return;
+    }
     scaleManager_.SetComponent(entity, scale);
+    MarkDirty(entity);
 }
 
 degree_t TransformManager::GetRotation(Entity entity) const
@@ -60,7 +74,12 @@ degree_t TransformManager::GetRotation(Entity entity) const
 
 void TransformManager::SetRotation(Entity entity, degree_t rotation)
 {
+    if (rotationManager_.GetComponent(entity) == rotation)
+    {
+        return;
+    }
     rotationManager_.SetComponent(entity, rotation);
+    MarkDirty(entity);
 }
 
 void TransformManager::AddComponent(Entity entity)
@@ -68,6 +87,7 @@ void TransformManager::AddComponent(Entity entity)
     positionManager_.AddComponent(entity);
     scaleManager_.AddComponent(entity);
     rotationManager_.AddComponent(entity);
+    MarkDirty(entity);
 }
 
 void TransformManager::RemoveComponent(Entity entity)
@@ -76,4 +96,36 @@ void TransformManager::RemoveComponent(Entity entity)
     scaleManager_.AddComponent(entity);
     rotationManager_.AddComponent(entity);
 }
+
+void TransformManager::ClearDirtyEntities()
+{
+    for (const auto entity : dirtyEntities_)
+    {
+        dirtyFlags_[entity] = 0;
+    }
+    dirtyEntities_.clear();
+}
+
+void TransformManager::MarkDirty(Entity entity)
+{
+    if (entity >= dirtyFlags_.size())
+    {
+        dirtyFlags_.resize(std::max<std::size_t>(entity + 1, positionManager_.GetAllComponents().size()), 0);
+    }
+    if (dirtyFlags_[entity] == 0)
+    {
+        dirtyFlags_[entity] = 1;
+        dirtyEntities_.push_back(entity);
+    }
+}
+
+MemoryUsage TransformManager::GetMemoryUsage() const
+{
+    auto usage = positionManager_.GetMemoryUsage();
+    usage += scaleManager_.GetMemoryUsage();
+    usage += rotationManager_.GetMemoryUsage();
+    usage += core::GetMemoryUsage(dirtyFlags_);
+    usage += core::GetMemoryUsage(dirtyEntities_);
+    return usage;
+}
 }
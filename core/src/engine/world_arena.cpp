@@ -0,0 +1,30 @@
+#include <engine/world_arena.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace core
+{
+
+WorldArena::WorldArena(std::size_t capacity) :
+    data_(std::make_unique<std::byte[]>(capacity)), capacity_(capacity)
+{
+}
+
+void WorldArena::CopyFrom(const WorldArena& other)
+{
+    assert(size_ == other.size_ && "World arenas with different layouts");
+    std::memcpy(data_.get(), other.data_.get(), std::min(size_, other.size_));
+}
+
+bool WorldArena::SetBytes(std::span<const std::byte> bytes)
+{
+    if (bytes.size() != size_)
+    {
+        CORE_LOG_ERROR("[WorldArena] Restoring a state of {} bytes in an arena of {} bytes", bytes.size(), size_);
+        return false;
+    }
+    std::memcpy(data_.get(), bytes.data(), size_);
+    return true;
+}
+} // namespace core
@@ -0,0 +1,55 @@
+#include <graphics/render_snapshot.h>
+
+#include <SFML/Graphics/Text.hpp>
+
+namespace core
+{
+    void RenderSnapshot::Clear(const sf::View& defaultView)
+    {
+        worldView = defaultView;
+        hudView = defaultView;
+        backgrounds.clear();
+        sprites.clear();
+        texts.clear();
+    }
+
+    void RenderSnapshot::Draw(sf::RenderTarget& target, SpriteBatch& spriteBatch) const
+    {
+        target.setView(worldView);
+        for (const auto* background : backgrounds)
+        {
+            target.draw(*background);
+        }
+        spriteBatch.Clear();
+        for (const auto& sprite : sprites)
+        {
+            spriteBatch.Add(sprite);
+        }
+        spriteBatch.Draw(target);
+
+        target.setView(hudView);
+        sf::Text textRenderer;
+        for (const auto& text : texts)
+        {
+            if (text.font == nullptr)
+            {
+                continue;
+            }
+            textRenderer.setFont(*text.font);
+            textRenderer.setString(text.text);
+            textRenderer.setCharacterSize(text.characterSize);
+            textRenderer.setFillColor(text.color);
+            if (text.centered)
+            {
+                const auto textBounds = textRenderer.getLocalBounds();
+                textRenderer.setOrigin(textBounds.width / 2.0f, textBounds.height / 2.0f);
+            }
+            else
+            {
+                textRenderer.setOrigin(0.0f, 0.0f);
+            }
+            textRenderer.setPosition(text.position);
+            target.draw(textRenderer);
+        }
+    }
+}
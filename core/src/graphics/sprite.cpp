@@ -13,32 +13,89 @@ namespace core
         components_[entity].setTexture(texture);
     }
 
+    void SpriteManager::SetTexture(Entity entity, const sf::Texture& texture, const sf::IntRect& textureRect)
+    {
+        components_[entity].setTexture(texture);
+        components_[entity].setTextureRect(textureRect);
+    }
+
+    void SpriteManager::AddComponent(Entity entity)
+    {
+        ComponentManager::AddComponent(entity);
+        //The transform may have been set before the sprite was added
+        transformManager_.MarkDirty(entity);
+    }
+
     void SpriteManager::Draw(sf::RenderTarget& window)
     {
+        UpdateTransforms();
+        spriteBatch_.Clear();
         for (Entity entity = 0; entity < components_.size(); entity++)
         {
             if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::SPRITE)))
             {
-                if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::POSITION)))
-                {
-                    const auto position = transformManager_.GetPosition(entity);
-                    components_[entity].setPosition(
-                        position.x * pixelPerMeter + center_.x,
-                        windowSize_.y - (position.y * pixelPerMeter + center_.y));
-                }
-                if(entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::SCALE)))
-                {
-                    const auto scale = transformManager_.GetScale(entity);
-                    components_[entity].setScale(scale.x, scale.y);
-                }
-                if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::ROTATION)))
-                {
-                    const auto rotation = transformManager_.GetRotation(entity);
-                    components_[entity].setRotation(rotation.value());
-                }
-                window.draw(components_[entity]);
+                spriteBatch_.Add(components_[entity]);
+            }
+        }
+        spriteBatch_.Draw(window);
+    }
+
+    void SpriteManager::CopySprites(std::vector<sf::Sprite>& sprites)
+    {
+        UpdateTransforms();
+        for (Entity entity = 0; entity < components_.size(); entity++)
+        {
+            if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::SPRITE)))
+            {
+                sprites.push_back(components_[entity]);
+            }
+        }
+    }
+
+    void SpriteManager::UpdateTransforms()
+    {
+        if (updateAllTransforms_)
+        {
+            for (Entity entity = 0; entity < components_.size(); entity++)
+            {
+                UpdateTransform(entity);
+            }
+            updateAllTransforms_ = false;
+        }
+        else
+        {
+            for (const auto entity : transformManager_.GetDirtyEntities())
+            {
+                UpdateTransform(entity);
             }
         }
+        transformManager_.ClearDirtyEntities();
+    }
+
+    void SpriteManager::UpdateTransform(Entity entity)
+    {
+        if (entity >= components_.size() ||
+            !entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::SPRITE)))
+        {
+            return;
+        }
+        if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::POSITION)))
+        {
+            const auto position = transformManager_.GetPosition(entity);
+            components_[entity].setPosition(
+                position.x * pixelPerMeter + center_.x,
+                windowSize_.y - (position.y * pixelPerMeter + center_.y));
+        }
+        if(entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::SCALE)))
+        {
+            const auto scale = transformManager_.GetScale(entity);
+            components_[entity].setScale(scale.x, scale.y);
+        }
+        if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::ROTATION)))
+        {
+            const auto rotation = transformManager_.GetRotation(entity);
+            components_[entity].setRotation(rotation.value());
+        }
     }
 
     void SpriteManager::SetColor(Entity entity, sf::Color color)
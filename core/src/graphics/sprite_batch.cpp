@@ -0,0 +1,45 @@
+#include <graphics/sprite_batch.h>
+
+#include <cmath>
+
+namespace core
+{
+    void SpriteBatch::Clear()
+    {
+        vertices_.clear();
+        batches_.clear();
+    }
+
+    void SpriteBatch::Add(const sf::Sprite& sprite)
+    {
+        const auto* texture = sprite.getTexture();
+        if (batches_.empty() || batches_.back().texture != texture)
+        {
+            batches_.push_back({ texture, vertices_.size(), 0 });
+        }
+        //Same local quad and texture coordinates as sf::Sprite, negative texture rect sizes flip the sprite
+        const auto& textureRect = sprite.getTextureRect();
+        const auto width = static_cast<float>(std::abs(textureRect.width));
+        const auto height = static_cast<float>(std::abs(textureRect.height));
+        const auto left = static_cast<float>(textureRect.left);
+        const auto right = left + static_cast<float>(textureRect.width);
+        const auto top = static_cast<float>(textureRect.top);
+        const auto bottom = top + static_cast<float>(textureRect.height);
+        const auto& transform = sprite.getTransform();
+        const auto& color = sprite.getColor();
+        vertices_.emplace_back(transform.transformPoint(0.0f, 0.0f), color, sf::Vector2f(left, top));
+        vertices_.emplace_back(transform.transformPoint(width, 0.0f), color, sf::Vector2f(right, top));
+        vertices_.emplace_back(transform.transformPoint(width, height), color, sf::Vector2f(right, bottom));
+        vertices_.emplace_back(transform.transformPoint(0.0f, height), color, sf::Vector2f(left, bottom));
+        batches_.back().vertexCount += 4;
+    }
+
+    void SpriteBatch::Draw(sf::RenderTarget& target, sf::RenderStates states) const
+    {
+        for (const auto& batch : batches_)
+        {
+            states.texture = batch.texture;
+            target.draw(vertices_.data() + batch.vertexStart, batch.vertexCount, sf::Quads, states);
+        }
+    }
+}
@@ -0,0 +1,142 @@
+#include <graphics/texture_atlas.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <numeric>
+
+#include <fmt/format.h>
+
+#include "utils/log.h"
+
+namespace core
+{
+    bool TextureAtlas::AddImage(std::string_view name, const std::string& path)
+    {
+        Entry entry;
+        entry.name = name;
+        if (!entry.image.loadFromFile(path))
+        {
+            CORE_LOG_ERROR("[TextureAtlas] Could not load image {}", path);
+            return false;
+        }
+        entries_.push_back(std::move(entry));
+        return true;
+    }
+
+    bool TextureAtlas::AddDirectory(const std::string& path)
+    {
+        std::error_code errorCode;
+        std::vector<std::filesystem::path> imagePaths;
+        for (const auto& file : std::filesystem::directory_iterator(path, errorCode))
+        {
+            const auto extension = file.path().extension().string();
+            if (file.is_regular_file() && (extension == ".png" || extension == ".jpg"))
+            {
+                imagePaths.push_back(file.path());
+            }
+        }
+        if (errorCode)
+        {
+            CORE_LOG_ERROR("[TextureAtlas] Could not read directory {}", path);
+            return false;
+        }
+        //Directory order is not specified, sort to get the same atlas everywhere
+        std::sort(imagePaths.begin(), imagePaths.end());
+        bool result = true;
+        for (const auto& imagePath : imagePaths)
+        {
+            result = AddImage(imagePath.filename().string(), imagePath.string()) && result;
+        }
+        return result;
+    }
+
+    bool TextureAtlas::Build()
+    {
+        if (entries_.empty())
+        {
+            LogError("[TextureAtlas] No image to pack");
+            return false;
+        }
+        std::vector<std::size_t> order(entries_.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b)
+        {
+            return entries_[a].image.getSize().y > entries_[b].image.getSize().y;
+        });
+
+        //Square-ish power of two width, at least as wide as the widest image
+        unsigned area = 0;
+        unsigned maxWidth = 0;
+        for (const auto& entry : entries_)
+        {
+            const auto size = entry.image.getSize();
+            area += (size.x + padding) * (size.y + padding);
+            maxWidth = std::max(maxWidth, size.x + padding);
+        }
+        unsigned atlasWidth = 1;
+        while (atlasWidth < std::max(maxWidth, static_cast<unsigned>(std::ceil(std::sqrt(area)))))
+        {
+            atlasWidth *= 2;
+        }
+
+        unsigned shelfX = 0;
+        unsigned shelfY = 0;
+        unsigned shelfHeight = 0;
+        for (const auto index : order)
+        {
+            auto& entry = entries_[index];
+            const auto size = entry.image.getSize();
+            if (shelfX + size.x + padding > atlasWidth)
+            {
+                shelfY += shelfHeight;
+                shelfX = 0;
+                shelfHeight = 0;
+            }
+            entry.rect = sf::IntRect(static_cast<int>(shelfX), static_cast<int>(shelfY),
+                static_cast<int>(size.x), static_cast<int>(size.y));
+            shelfX += size.x + padding;
+            shelfHeight = std::max(shelfHeight, size.y + padding);
+        }
+        const unsigned atlasHeight = shelfY + shelfHeight;
+        if (atlasWidth > sf::Texture::getMaximumSize() || atlasHeight > sf::Texture::getMaximumSize())
+        {
+            CORE_LOG_ERROR("[TextureAtlas] Atlas of {}x{} is bigger than the maximum texture size",
+                atlasWidth, atlasHeight);
+            return false;
+        }
+
+        sf::Image atlasImage;
+        atlasImage.create(atlasWidth, atlasHeight, sf::Color::Transparent);
+        for (const auto& entry : entries_)
+        {
+            atlasImage.copy(entry.image,
+                static_cast<unsigned>(entry.rect.left), static_cast<unsigned>(entry.rect.top));
+        }
+        if (!texture_.loadFromImage(atlasImage))
+        {
+            LogError("[TextureAtlas] Could not create the atlas texture");
+            return false;
+        }
+        //The source images are not needed once uploaded
+        for (auto& entry : entries_)
+        {
+            entry.image = sf::Image();
+        }
+        CORE_LOG_DEBUG("[TextureAtlas] Packed {} images in {}x{}", entries_.size(), atlasWidth, atlasHeight);
+        built_ = true;
+        return true;
+    }
+
+    sf::IntRect TextureAtlas::GetRect(std::string_view name) const
+    {
+        const auto it = std::find_if(entries_.begin(), entries_.end(),
+            [name](const Entry& entry) { return entry.name == name; });
+        if (it == entries_.end())
+        {
+            CORE_LOG_ERROR("[TextureAtlas] No image named {} in the atlas", name);
+            return {};
+        }
+        return it->rect;
+    }
+}
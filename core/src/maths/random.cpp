@@ -0,0 +1,27 @@
+#include <maths/random.h>
+
+#include <random>
+
+namespace core
+{
+void Rng::Fill(std::span<float> values, float start, float end)
+{
+    const auto scale = (end - start) * (1.0f / 16777216.0f);
+    for (auto& value : values)
+    {
+        value = start + static_cast<float>(Next() >> 8u) * scale;
+    }
+}
+
+Rng& GetThreadRng()
+{
+    thread_local Rng rng = []()
+    {
+        std::random_device randomDevice;
+        const auto seed = (static_cast<std::uint64_t>(randomDevice()) << 32u) | randomDevice();
+        const auto stream = (static_cast<std::uint64_t>(randomDevice()) << 32u) | randomDevice();
+        return Rng(seed, stream);
+    }();
+    return rng;
+}
+}
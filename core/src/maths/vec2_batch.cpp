@@ -0,0 +1,145 @@
+#include <maths/vec2_batch.h>
+
+#include <cassert>
+
+#if defined(CORE_VEC2_SSE2)
+#include <emmintrin.h>
+#elif defined(CORE_VEC2_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace core
+{
+void Integrate(std::span<Vec2f> positions, std::span<const Vec2f> velocities, float dt)
+{
+    assert(positions.size() == velocities.size());
+    std::size_t i = 0;
+    auto* positionPtr = reinterpret_cast<float*>(positions.data());
+    const auto* velocityPtr = reinterpret_cast<const float*>(velocities.data());
+#if defined(CORE_VEC2_SSE2)
+    const auto dtVec = _mm_set1_ps(dt);
+    for (; i + 2 <= positions.size(); i += 2)
+    {
+        const auto position = _mm_loadu_ps(positionPtr + 2 * i);
+        const auto velocity = _mm_loadu_ps(velocityPtr + 2 * i);
+        _mm_storeu_ps(positionPtr + 2 * i, _mm_add_ps(position, _mm_mul_ps(velocity, dtVec)));
+    }
+#elif defined(CORE_VEC2_NEON)
+    for (; i + 2 <= positions.size(); i += 2)
+    {
+        const auto position = vld1q_f32(positionPtr + 2 * i);
+        const auto velocity = vld1q_f32(velocityPtr + 2 * i);
+        vst1q_f32(positionPtr + 2 * i, vmlaq_n_f32(position, velocity, dt));
+    }
+#endif
+    for (; i < positions.size(); i++)
+    {
+        positions[i] += velocities[i] * dt;
+    }
+}
+
+void ScaleAndOffset(std::span<const Vec2f> vectors, Vec2f scale, Vec2f offset, std::span<Vec2f> result)
+{
+    assert(vectors.size() == result.size());
+    std::size_t i = 0;
+    const auto* vectorPtr = reinterpret_cast<const float*>(vectors.data());
+    auto* resultPtr = reinterpret_cast<float*>(result.data());
+#if defined(CORE_VEC2_SSE2)
+    const auto scaleVec = _mm_setr_ps(scale.x, scale.y, scale.x, scale.y);
+    const auto offsetVec = _mm_setr_ps(offset.x, offset.y, offset.x, offset.y);
+    for (; i + 2 <= vectors.size(); i += 2)
+    {
+        const auto vector = _mm_loadu_ps(vectorPtr + 2 * i);
+        _mm_storeu_ps(resultPtr + 2 * i, _mm_add_ps(_mm_mul_ps(vector, scaleVec), offsetVec));
+    }
+#elif defined(CORE_VEC2_NEON)
+    const float scaleArray[4] = { scale.x, scale.y, scale.x, scale.y };
+    const float offsetArray[4] = { offset.x, offset.y, offset.x, offset.y };
+    const auto scaleVec = vld1q_f32(scaleArray);
+    const auto offsetVec = vld1q_f32(offsetArray);
+    for (; i + 2 <= vectors.size(); i += 2)
+    {
+        const auto vector = vld1q_f32(vectorPtr + 2 * i);
+        vst1q_f32(resultPtr + 2 * i, vmlaq_f32(offsetVec, vector, scaleVec));
+    }
+#endif
+    for (; i < vectors.size(); i++)
+    {
+        result[i] = Vec2f(vectors[i].x * scale.x, vectors[i].y * scale.y) + offset;
+    }
+}
+
+void Dot(std::span<const Vec2f> a, std::span<const Vec2f> b, std::span<float> result)
+{
+    assert(a.size() == b.size() && a.size() == result.size());
+    std::size_t i = 0;
+    const auto* aPtr = reinterpret_cast<const float*>(a.data());
+    const auto* bPtr = reinterpret_cast<const float*>(b.data());
+#if defined(CORE_VEC2_SSE2)
+    for (; i + 4 <= a.size(); i += 4)
+    {
+        //Products of 2 vectors per register, then x products + y products of the 4 vectors
+        const auto products01 = _mm_mul_ps(_mm_loadu_ps(aPtr + 2 * i), _mm_loadu_ps(bPtr + 2 * i));
+        const auto products23 = _mm_mul_ps(_mm_loadu_ps(aPtr + 2 * i + 4), _mm_loadu_ps(bPtr + 2 * i + 4));
+        const auto xProducts = _mm_shuffle_ps(products01, products23, _MM_SHUFFLE(2, 0, 2, 0));
+        const auto yProducts = _mm_shuffle_ps(products01, products23, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_ps(result.data() + i, _mm_add_ps(xProducts, yProducts));
+    }
+#elif defined(CORE_VEC2_NEON)
+    for (; i + 4 <= a.size(); i += 4)
+    {
+        //Deinterleaving loads put the x and the y of 4 vectors in separate registers
+        const auto aVec = vld2q_f32(aPtr + 2 * i);
+        const auto bVec = vld2q_f32(bPtr + 2 * i);
+        vst1q_f32(result.data() + i, vmlaq_f32(vmulq_f32(aVec.val[0], bVec.val[0]), aVec.val[1], bVec.val[1]));
+    }
+#endif
+    for (; i < a.size(); i++)
+    {
+        result[i] = Vec2f::Dot(a[i], b[i]);
+    }
+}
+
+std::size_t Overlaps(const Aabb& box, std::span<const Aabb> boxes, std::span<std::uint8_t> overlaps)
+{
+    assert(boxes.size() == overlaps.size());
+    std::size_t overlapCount = 0;
+    std::size_t i = 0;
+#if defined(CORE_VEC2_SSE2)
+    //box as (min.x, min.y, max.x, max.y) against other as (max.x, max.y, min.x, min.y):
+    //the 2 low lanes must be <= and the 2 high lanes >=
+    const auto boxVec = _mm_setr_ps(box.min.x, box.min.y, box.max.x, box.max.y);
+    for (; i < boxes.size(); i++)
+    {
+        const auto other = _mm_loadu_ps(reinterpret_cast<const float*>(&boxes[i]));
+        const auto swapped = _mm_shuffle_ps(other, other, _MM_SHUFFLE(1, 0, 3, 2));
+        const auto lowerMask = _mm_movemask_ps(_mm_cmple_ps(boxVec, swapped));
+        const auto greaterMask = _mm_movemask_ps(_mm_cmpge_ps(boxVec, swapped));
+        const bool overlap = (lowerMask & 0x3) == 0x3 && (greaterMask & 0xC) == 0xC;
+        overlaps[i] = overlap ? 1u : 0u;
+        overlapCount += overlap ? 1u : 0u;
+    }
+#elif defined(CORE_VEC2_NEON)
+    const float boxArray[4] = { box.min.x, box.min.y, box.max.x, box.max.y };
+    const auto boxVec = vld1q_f32(boxArray);
+    for (; i < boxes.size(); i++)
+    {
+        const auto other = vld1q_f32(reinterpret_cast<const float*>(&boxes[i]));
+        const auto swapped = vextq_f32(other, other, 2);
+        const auto lower = vcleq_f32(boxVec, swapped);
+        const auto greater = vcgeq_f32(boxVec, swapped);
+        const bool overlap = vgetq_lane_u32(lower, 0) && vgetq_lane_u32(lower, 1) &&
+            vgetq_lane_u32(greater, 2) && vgetq_lane_u32(greater, 3);
+        overlaps[i] = overlap ? 1u : 0u;
+        overlapCount += overlap ? 1u : 0u;
+    }
+#endif
+    for (; i < boxes.size(); i++)
+    {
+        const bool overlap = box.Overlaps(boxes[i]);
+        overlaps[i] = overlap ? 1u : 0u;
+        overlapCount += overlap ? 1u : 0u;
+    }
+    return overlapCount;
+}
+}
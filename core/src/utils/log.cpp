@@ -1,21 +1,81 @@
 #include <utils/log.h>
+
+#include <atomic>
+
 #include "spdlog/spdlog.h"
+#include "spdlog/async.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
 
 namespace core
 {
+namespace
+{
+std::atomic<LogLevel> logLevel{ LogLevel::Debug };
+
+spdlog::level::level_enum ToSpdlogLevel(LogLevel level)
+{
+    switch (level)
+    {
+    case LogLevel::Debug:
+        return spdlog::level::debug;
+    case LogLevel::Warning:
+        return spdlog::level::warn;
+    case LogLevel::Error:
+        return spdlog::level::err;
+    default:
+        return spdlog::level::off;
+    }
+}
+
+//spdlog drops debug messages by default, the filtering is done by logLevel
+const bool spdlogLevelInitialized = (spdlog::set_level(spdlog::level::debug), true);
+}
+
+void SetLogLevel(LogLevel level)
+{
+    logLevel.store(level, std::memory_order_relaxed);
+    spdlog::set_level(ToSpdlogLevel(level));
+}
+
+bool IsLogEnabled(LogLevel level)
+{
+    return level >= logLevel.load(std::memory_order_relaxed);
+}
+
+void InitAsyncLogging(std::size_t queueSize)
+{
+    spdlog::init_thread_pool(queueSize, 1);
+    auto logger = spdlog::create_async<spdlog::sinks::stdout_color_sink_mt>("async");
+    logger->set_level(ToSpdlogLevel(logLevel.load(std::memory_order_relaxed)));
+    spdlog::set_default_logger(std::move(logger));
+}
+
+void ShutdownLogging()
+{
+    spdlog::shutdown();
+}
 
 void LogDebug(const std::string_view msg)
 {
-    spdlog::info(msg);
+    if (IsLogEnabled(LogLevel::Debug))
+    {
+        spdlog::debug(msg);
+    }
 }
 
 void LogWarning(const std::string_view msg)
 {
-    spdlog::warn(msg);
+    if (IsLogEnabled(LogLevel::Warning))
+    {
+        spdlog::warn(msg);
+    }
 }
 
 void LogError(const std::string_view msg)
 {
-    spdlog::error(msg);
+    if (IsLogEnabled(LogLevel::Error))
+    {
+        spdlog::error(msg);
+    }
 }
 }
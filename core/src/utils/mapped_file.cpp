@@ -0,0 +1,119 @@
+#include <utils/mapped_file.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "utils/log.h"
+
+namespace core
+{
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+    const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        LogError("Could not open file to map: " + path);
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        LogError("Could not map empty file: " + path);
+        CloseHandle(file);
+        return false;
+    }
+    const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
+    {
+        LogError("Could not create file mapping: " + path);
+        CloseHandle(file);
+        return false;
+    }
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        LogError("Could not map view of file: " + path);
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle_ = file;
+    mappingHandle_ = mapping;
+    data_ = static_cast<const std::uint8_t*>(view);
+    size_ = static_cast<std::size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data_ != nullptr)
+    {
+        UnmapViewOfFile(data_);
+        CloseHandle(mappingHandle_);
+        CloseHandle(fileHandle_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    fileHandle_ = nullptr;
+    mappingHandle_ = nullptr;
+}
+#else
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+    const int file = open(path.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        LogError("Could not open file to map: " + path);
+        return false;
+    }
+    struct stat fileStat{};
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        LogError("Could not map empty file: " + path);
+        close(file);
+        return false;
+    }
+    const auto size = static_cast<std::size_t>(fileStat.st_size);
+    void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    //The mapping stays valid once the descriptor is closed
+    close(file);
+    if (view == MAP_FAILED)
+    {
+        LogError("Could not map file: " + path);
+        return false;
+    }
+    //Seeking jumps around the file
+    madvise(view, size, MADV_RANDOM);
+    data_ = static_cast<const std::uint8_t*>(view);
+    size_ = size;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data_ != nullptr)
+    {
+        munmap(const_cast<std::uint8_t*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+#endif
+} // namespace core
@@ -0,0 +1,223 @@
+#include <utils/memory.h>
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <imgui.h>
+
+#include "utils/log.h"
+
+namespace core
+{
+namespace
+{
+struct MemoryTagCounters
+{
+    std::atomic<std::size_t> currentBytes{ 0 };
+    std::atomic<std::size_t> peakBytes{ 0 };
+    std::atomic<std::uint64_t> allocationCount{ 0 };
+};
+
+std::array<MemoryTagCounters, static_cast<std::size_t>(MemoryTag::Length)> memoryTagCounters;
+thread_local MemoryTag currentMemoryTag = MemoryTag::Untagged;
+
+constexpr std::array<const char*, static_cast<std::size_t>(MemoryTag::Length)> memoryTagNames =
+{
+    "Untagged",
+    "Entities",
+    "Components",
+    "Rollback",
+    "Replay",
+    "Network",
+    "Graphics",
+};
+}
+
+const char* GetMemoryTagName(MemoryTag tag)
+{
+    return memoryTagNames[static_cast<std::size_t>(tag)];
+}
+
+bool IsMemoryTrackingEnabled()
+{
+#ifdef CORE_TRACK_MEMORY
+    return true;
+#else
+    return false;
+#endif
+}
+
+MemoryTagStats GetMemoryTagStats(MemoryTag tag)
+{
+    const auto& counters = memoryTagCounters[static_cast<std::size_t>(tag)];
+    return {
+        counters.currentBytes.load(std::memory_order_relaxed),
+        counters.peakBytes.load(std::memory_order_relaxed),
+        counters.allocationCount.load(std::memory_order_relaxed)
+    };
+}
+
+MemoryTag GetCurrentMemoryTag()
+{
+    return currentMemoryTag;
+}
+
+MemoryTagScope::MemoryTagScope(MemoryTag tag) : previousTag_(currentMemoryTag)
+{
+    currentMemoryTag = tag;
+}
+
+MemoryTagScope::~MemoryTagScope()
+{
+    currentMemoryTag = previousTag_;
+}
+
+void MemoryReport::Add(std::string_view subsystem, std::string_view name, MemoryUsage usage)
+{
+    entries_.push_back({ std::string(subsystem), std::string(name), usage });
+}
+
+MemoryUsage MemoryReport::GetTotal() const
+{
+    MemoryUsage total;
+    for (const auto& entry : entries_)
+    {
+        total += entry.usage;
+    }
+    return total;
+}
+
+MemoryUsage MemoryReport::GetSubsystemTotal(std::string_view subsystem) const
+{
+    MemoryUsage total;
+    for (const auto& entry : entries_)
+    {
+        if (entry.subsystem == subsystem)
+        {
+            total += entry.usage;
+        }
+    }
+    return total;
+}
+
+void MemoryReport::Log() const
+{
+    const auto total = GetTotal();
+    CORE_LOG_DEBUG("[Memory] Total: {} bytes reserved, {} bytes live", total.capacityBytes, total.liveBytes);
+    for (const auto& entry : entries_)
+    {
+        CORE_LOG_DEBUG("[Memory] {} / {}: {} bytes reserved, {} bytes live",
+            entry.subsystem, entry.name, entry.usage.capacityBytes, entry.usage.liveBytes);
+    }
+    if (!IsMemoryTrackingEnabled())
+    {
+        return;
+    }
+    for (std::size_t tag = 0; tag < memoryTagCounters.size(); tag++)
+    {
+        const auto stats = GetMemoryTagStats(static_cast<MemoryTag>(tag));
+        CORE_LOG_DEBUG("[Memory] Tag {}: {} bytes, peak {} bytes, {} allocations",
+            memoryTagNames[tag], stats.currentBytes, stats.peakBytes, stats.allocationCount);
+    }
+}
+
+void MemoryReport::DrawImGui() const
+{
+    if (!ImGui::CollapsingHeader("Memory"))
+    {
+        return;
+    }
+    const auto total = GetTotal();
+    ImGui::Text("Managers: %zu KiB reserved, %zu KiB live", total.capacityBytes / 1024, total.liveBytes / 1024);
+    const std::string* subsystem = nullptr;
+    for (const auto& entry : entries_)
+    {
+        if (subsystem == nullptr || *subsystem != entry.subsystem)
+        {
+            subsystem = &entry.subsystem;
+            const auto subsystemTotal = GetSubsystemTotal(entry.subsystem);
+            ImGui::Text("%s: %zu B reserved, %zu B live", entry.subsystem.c_str(),
+                subsystemTotal.capacityBytes, subsystemTotal.liveBytes);
+        }
+        ImGui::Text("    %s: %zu B reserved, %zu B live", entry.name.c_str(),
+            entry.usage.capacityBytes, entry.usage.liveBytes);
+    }
+    if (!IsMemoryTrackingEnabled())
+    {
+        ImGui::TextUnformatted("Heap tags: build with ENABLE_MEMORY_TRACKING");
+        return;
+    }
+    for (std::size_t tag = 0; tag < memoryTagCounters.size(); tag++)
+    {
+        const auto stats = GetMemoryTagStats(static_cast<MemoryTag>(tag));
+        ImGui::Text("Heap %s: %zu KiB, peak %zu KiB, %llu allocations", memoryTagNames[tag],
+            stats.currentBytes / 1024, stats.peakBytes / 1024,
+            static_cast<unsigned long long>(stats.allocationCount));
+    }
+}
+}
+
+#ifdef CORE_TRACK_MEMORY
+namespace
+{
+/**
+ * \brief Prepended to each allocation to account its size to its tag when freed,
+ * its size keeps the default new alignment
+ */
+struct alignas(alignof(std::max_align_t)) AllocationHeader
+{
+    std::size_t size;
+    core::MemoryTag tag;
+};
+
+void* TrackedAllocate(std::size_t size)
+{
+    auto* header = static_cast<AllocationHeader*>(std::malloc(sizeof(AllocationHeader) + size));
+    if (header == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    header->size = size;
+    header->tag = core::currentMemoryTag;
+    auto& counters = core::memoryTagCounters[static_cast<std::size_t>(header->tag)];
+    const auto currentBytes = counters.currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    counters.allocationCount.fetch_add(1, std::memory_order_relaxed);
+    auto peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+    while (currentBytes > peakBytes &&
+        !counters.peakBytes.compare_exchange_weak(peakBytes, currentBytes, std::memory_order_relaxed))
+    {
+    }
+    return header + 1;
+}
+
+void TrackedFree(void* ptr)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    auto* header = static_cast<AllocationHeader*>(ptr) - 1;
+    core::memoryTagCounters[static_cast<std::size_t>(header->tag)].currentBytes.fetch_sub(
+        header->size, std::memory_order_relaxed);
+    std::free(header);
+}
+}
+
+//The array and nothrow forms forward to these ones, the aligned forms are left untracked
+void* operator new(std::size_t size)
+{
+    return TrackedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    TrackedFree(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    TrackedFree(ptr);
+}
+#endif
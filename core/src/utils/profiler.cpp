@@ -0,0 +1,216 @@
+#include <utils/profiler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <unordered_map>
+
+#include <fmt/format.h>
+#include <imgui.h>
+
+#include "utils/log.h"
+
+namespace core
+{
+namespace
+{
+std::int64_t GetSteadyTimeNs()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+thread_local std::uint32_t zoneDepth = 0;
+}
+
+Profiler& Profiler::Get()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : creationTimeNs_(GetSteadyTimeNs())
+{
+}
+
+std::int64_t Profiler::GetTimeNs() const
+{
+    return GetSteadyTimeNs() - creationTimeNs_;
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+{
+    thread_local ThreadBuffer* threadBuffer = nullptr;
+    if (threadBuffer == nullptr)
+    {
+        //Only the first zone of a thread locks, the buffers are kept after the thread exits for the dumps
+        std::scoped_lock lock(buffersMutex_);
+        auto& buffer = buffers_.emplace_back(std::make_unique<ThreadBuffer>());
+        buffer->threadIndex = static_cast<std::uint32_t>(buffers_.size() - 1);
+        threadBuffer = buffer.get();
+    }
+    return *threadBuffer;
+}
+
+void Profiler::Record(const char* name, std::int64_t startNs, std::int64_t endNs, std::uint32_t depth)
+{
+    auto& buffer = GetThreadBuffer();
+    const auto writeIndex = buffer.writeIndex.load(std::memory_order_relaxed);
+    buffer.events[writeIndex % ringSize] = { name, startNs, endNs, buffer.threadIndex, depth };
+    buffer.writeIndex.store(writeIndex + 1, std::memory_order_release);
+}
+
+void Profiler::MarkFrame()
+{
+    const auto now = GetTimeNs();
+    const auto frameStart = frameStartNs_.exchange(now, std::memory_order_relaxed);
+    lastFrameStartNs_.store(frameStart, std::memory_order_relaxed);
+    lastFrameEndNs_.store(now, std::memory_order_relaxed);
+}
+
+void Profiler::CollectEvents(std::vector<ProfileEvent>& events, std::int64_t startNs, std::int64_t endNs) const
+{
+    std::scoped_lock lock(buffersMutex_);
+    for (const auto& buffer : buffers_)
+    {
+        const auto writeIndex = buffer->writeIndex.load(std::memory_order_acquire);
+        //The oldest quarter of the ring is skipped, the writing thread could be overwriting it
+        constexpr std::uint64_t readableSize = ringSize - ringSize / 4;
+        const auto readIndex = writeIndex > readableSize ? writeIndex - readableSize : 0;
+        for (auto i = readIndex; i < writeIndex; i++)
+        {
+            const auto& event = buffer->events[i % ringSize];
+            if (event.endNs > startNs && event.startNs < endNs)
+            {
+                events.push_back(event);
+            }
+        }
+    }
+    std::sort(events.begin(), events.end(), [](const ProfileEvent& a, const ProfileEvent& b)
+    {
+        return a.threadIndex != b.threadIndex ? a.threadIndex < b.threadIndex : a.startNs < b.startNs;
+    });
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path) const
+{
+    std::vector<ProfileEvent> events;
+    CollectEvents(events, 0, GetTimeNs());
+    auto* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr)
+    {
+        CORE_LOG_ERROR("[Profiler] Could not open {} for writing", path);
+        return false;
+    }
+    fmt::print(file, "{{\"traceEvents\":[\n");
+    for (std::size_t i = 0; i < events.size(); i++)
+    {
+        const auto& event = events[i];
+        fmt::print(file, "{{\"name\":\"{}\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":0,\"tid\":{}}}{}\n",
+            event.name,
+            static_cast<double>(event.startNs) / 1000.0,
+            static_cast<double>(event.endNs - event.startNs) / 1000.0,
+            event.threadIndex,
+            i + 1 < events.size() ? "," : "");
+    }
+    fmt::print(file, "]}}\n");
+    std::fclose(file);
+    CORE_LOG_DEBUG("[Profiler] Wrote {} zones to {}", events.size(), path);
+    return true;
+}
+
+void Profiler::DrawImGui()
+{
+    ImGui::Begin("Profiler");
+    bool enabled = IsEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled))
+    {
+        SetEnabled(enabled);
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Pause", &timelinePaused_);
+    const auto frameStart = lastFrameStartNs_.load(std::memory_order_relaxed);
+    const auto frameEnd = lastFrameEndNs_.load(std::memory_order_relaxed);
+    if (!timelinePaused_)
+    {
+        timelineEvents_.clear();
+        CollectEvents(timelineEvents_, frameStart, frameEnd);
+    }
+    const auto frameDuration = static_cast<float>(std::max<std::int64_t>(frameEnd - frameStart, 1));
+    ImGui::Text("Last frame: %.3f ms", frameDuration / 1'000'000.0f);
+
+    //Timeline of the last frame, one row per thread and per zone depth
+    constexpr float rowHeight = 18.0f;
+    const auto width = ImGui::GetContentRegionAvail().x;
+    auto* drawList = ImGui::GetWindowDrawList();
+    const auto origin = ImGui::GetCursorScreenPos();
+    float rowY = 0.0f;
+    std::uint32_t maxDepth = 0;
+    std::uint32_t currentThread = timelineEvents_.empty() ? 0 : timelineEvents_.front().threadIndex;
+    for (const auto& event : timelineEvents_)
+    {
+        if (event.threadIndex != currentThread)
+        {
+            rowY += static_cast<float>(maxDepth + 1) * rowHeight + rowHeight / 2.0f;
+            maxDepth = 0;
+            currentThread = event.threadIndex;
+        }
+        maxDepth = std::max(maxDepth, event.depth);
+        const auto start = static_cast<float>(std::max(event.startNs, frameStart) - frameStart) / frameDuration;
+        const auto end = static_cast<float>(std::min(event.endNs, frameEnd) - frameStart) / frameDuration;
+        const ImVec2 min(origin.x + start * width, origin.y + rowY + static_cast<float>(event.depth) * rowHeight);
+        const ImVec2 max(origin.x + std::max(end * width, start * width + 1.0f), min.y + rowHeight - 1.0f);
+        const auto color = static_cast<ImU32>(std::hash<const char*>{}(event.name)) | 0xFF404040u;
+        drawList->AddRectFilled(min, max, color);
+        drawList->PushClipRect(min, max, true);
+        drawList->AddText(ImVec2(min.x + 2.0f, min.y + 1.0f), 0xFF000000u, event.name);
+        drawList->PopClipRect();
+        if (ImGui::IsMouseHoveringRect(min, max))
+        {
+            ImGui::SetTooltip("%s: %.3f ms", event.name,
+                static_cast<float>(event.endNs - event.startNs) / 1'000'000.0f);
+        }
+    }
+    rowY += static_cast<float>(maxDepth + 1) * rowHeight;
+    ImGui::Dummy(ImVec2(width, rowY));
+
+    //Total time per zone name in the frame
+    std::unordered_map<const char*, std::int64_t> zoneTimes;
+    for (const auto& event : timelineEvents_)
+    {
+        zoneTimes[event.name] += std::min(event.endNs, frameEnd) - std::max(event.startNs, frameStart);
+    }
+    std::vector<std::pair<const char*, std::int64_t>> sortedZoneTimes(zoneTimes.begin(), zoneTimes.end());
+    std::sort(sortedZoneTimes.begin(), sortedZoneTimes.end(), [](const auto& a, const auto& b)
+    {
+        return a.second > b.second;
+    });
+    for (const auto& [name, time] : sortedZoneTimes)
+    {
+        ImGui::Text("%s: %.3f ms", name, static_cast<float>(time) / 1'000'000.0f);
+    }
+    ImGui::End();
+}
+
+ProfileZone::ProfileZone(const char* name)
+{
+    if (!Profiler::Get().IsEnabled())
+    {
+        return;
+    }
+    name_ = name;
+    depth_ = zoneDepth++;
+    startNs_ = Profiler::Get().GetTimeNs();
+}
+
+ProfileZone::~ProfileZone()
+{
+    if (name_ == nullptr)
+    {
+        return;
+    }
+    zoneDepth--;
+    auto& profiler = Profiler::Get();
+    profiler.Record(name_, startNs_, profiler.GetTimeNs(), depth_);
+}
+}
@@ -0,0 +1,45 @@
+#include "utils/action_utility.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+    class Counter
+    {
+    public:
+        void Add(int value) { sum += value; }
+        int sum = 0;
+    };
+}
+
+TEST(Delegate, Lambda)
+{
+    int sum = 0;
+    core::Delegate<int> delegate([&sum](int value) { sum += value; });
+    EXPECT_TRUE(delegate);
+    delegate(3);
+    delegate(4);
+    EXPECT_EQ(7, sum);
+    EXPECT_FALSE(core::Delegate<int>());
+}
+
+TEST(Delegate, Bind)
+{
+    Counter counter;
+    const auto delegate = core::Delegate<int>::Bind<&Counter::Add>(counter);
+    const auto copy = delegate;
+    delegate(2);
+    copy(5);
+    EXPECT_EQ(7, counter.sum);
+}
+
+TEST(Action, Execute)
+{
+    Counter counter1;
+    Counter counter2;
+    core::Action<int> action;
+    action.RegisterCallback(core::Delegate<int>::Bind<&Counter::Add>(counter1));
+    action.RegisterCallback(core::Delegate<int>::Bind<&Counter::Add>(counter2));
+    action.Execute(10);
+    EXPECT_EQ(10, counter1.sum);
+    EXPECT_EQ(10, counter2.sum);
+}
@@ -34,4 +34,17 @@ TEST(Entity, EntityComponent)
     entityManager.AddComponent(newEntity, newComponent);
     entityManager.DestroyEntity(newEntity);
     EXPECT_FALSE(entityManager.HasComponent(newEntity, newComponent));
-}
\ No newline at end of file
+}
+
+TEST(Entity, GrowFromSmallCapacity)
+{
+    core::EntityManager entityManager(1);
+    const auto firstEntity = entityManager.CreateEntity();
+    const auto secondEntity = entityManager.CreateEntity();
+    EXPECT_NE(firstEntity, secondEntity);
+    EXPECT_GE(entityManager.GetEntitiesSize(), 2u);
+    EXPECT_TRUE(entityManager.EntityExists(secondEntity));
+
+    core::ComponentManager<int, 2u> componentManager(entityManager);
+    EXPECT_EQ(componentManager.GetAllComponents().size(), entityManager.GetEntitiesSize());
+}
@@ -0,0 +1,53 @@
+#include "maths/random.h"
+#include <gtest/gtest.h>
+
+#include <array>
+
+TEST(Random, SameSeedSameSequence)
+{
+    core::Rng rng1(42);
+    core::Rng rng2(42);
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(rng1.Next(), rng2.Next());
+    }
+    core::Rng rng3(43);
+    EXPECT_NE(rng1.Next(), rng3.Next());
+}
+
+TEST(Random, RestoreState)
+{
+    core::Rng rng(7);
+    rng.Next();
+    core::Rng copy;
+    copy.SetState(rng.GetState(), rng.GetIncrement());
+    EXPECT_EQ(rng, copy);
+    EXPECT_EQ(rng.Next(), copy.Next());
+}
+
+TEST(Random, Bounded)
+{
+    core::Rng rng;
+    for (int i = 0; i < 1000; i++)
+    {
+        EXPECT_LT(rng.NextBounded(3), 3u);
+        const auto value = rng.Range(-2.0f, 5.0f);
+        EXPECT_GE(value, -2.0f);
+        EXPECT_LT(value, 5.0f);
+    }
+}
+
+TEST(Random, Fill)
+{
+    core::Rng rng(1);
+    std::array<float, 256> values{};
+    rng.Fill(values, 10.0f, 20.0f);
+    for (const auto value : values)
+    {
+        EXPECT_GE(value, 10.0f);
+        EXPECT_LT(value, 20.0f);
+    }
+    //Fill draws the same numbers as Range
+    core::Rng rng2(1);
+    EXPECT_FLOAT_EQ(values[0], rng2.Range(10.0f, 20.0f));
+}
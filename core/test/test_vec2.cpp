@@ -0,0 +1,74 @@
+#include "maths/vec2_batch.h"
+#include <gtest/gtest.h>
+
+#include <array>
+
+TEST(Vec2, Constexpr)
+{
+    constexpr core::Vec2f v = core::Vec2f(1.0f, 2.0f) * 2.0f + core::Vec2f::one();
+    static_assert(v == core::Vec2f(3.0f, 5.0f));
+    static_assert(core::Vec2f::Dot(v, core::Vec2f::up()) == 5.0f);
+    EXPECT_FLOAT_EQ(5.0f, core::Vec2f(3.0f, 4.0f).GetMagnitude());
+}
+
+TEST(Vec2, Integrate)
+{
+    std::array<core::Vec2f, 5> positions{};
+    std::array<core::Vec2f, 5> velocities{};
+    for (std::size_t i = 0; i < positions.size(); i++)
+    {
+        positions[i] = { static_cast<float>(i), -static_cast<float>(i) };
+        velocities[i] = { 1.0f, static_cast<float>(i) };
+    }
+    core::Integrate(positions, velocities, 0.5f);
+    for (std::size_t i = 0; i < positions.size(); i++)
+    {
+        EXPECT_FLOAT_EQ(static_cast<float>(i) + 0.5f, positions[i].x);
+        EXPECT_FLOAT_EQ(-static_cast<float>(i) * 0.5f, positions[i].y);
+    }
+}
+
+TEST(Vec2, ScaleAndOffset)
+{
+    const std::array<core::Vec2f, 3> vectors = { core::Vec2f(1, 2), core::Vec2f(3, 4), core::Vec2f(5, 6) };
+    std::array<core::Vec2f, 3> result{};
+    core::ScaleAndOffset(vectors, core::Vec2f(2, -1), core::Vec2f(10, 10), result);
+    EXPECT_EQ(core::Vec2f(12, 8), result[0]);
+    EXPECT_EQ(core::Vec2f(16, 6), result[1]);
+    EXPECT_EQ(core::Vec2f(20, 4), result[2]);
+}
+
+TEST(Vec2, Dot)
+{
+    std::array<core::Vec2f, 7> a{};
+    std::array<core::Vec2f, 7> b{};
+    for (std::size_t i = 0; i < a.size(); i++)
+    {
+        a[i] = { static_cast<float>(i), 1.0f };
+        b[i] = { 2.0f, static_cast<float>(i) };
+    }
+    std::array<float, 7> result{};
+    core::Dot(a, b, result);
+    for (std::size_t i = 0; i < a.size(); i++)
+    {
+        EXPECT_FLOAT_EQ(core::Vec2f::Dot(a[i], b[i]), result[i]);
+    }
+}
+
+TEST(Vec2, Overlaps)
+{
+    const auto box = core::Aabb::FromCenter(core::Vec2f::zero(), core::Vec2f::one());
+    const std::array<core::Aabb, 4> boxes =
+    {
+        core::Aabb::FromCenter(core::Vec2f(1.5f, 0.0f), core::Vec2f::one()),
+        core::Aabb::FromCenter(core::Vec2f(3.0f, 0.0f), core::Vec2f::one()),
+        core::Aabb::FromCenter(core::Vec2f(0.0f, -2.0f), core::Vec2f::one()),
+        core::Aabb::FromCenter(core::Vec2f(0.0f, 2.5f), core::Vec2f::one()),
+    };
+    std::array<std::uint8_t, 4> overlaps{};
+    EXPECT_EQ(2u, core::Overlaps(box, boxes, overlaps));
+    EXPECT_EQ(1u, overlaps[0]);
+    EXPECT_EQ(0u, overlaps[1]);
+    EXPECT_EQ(1u, overlaps[2]);
+    EXPECT_EQ(0u, overlaps[3]);
+}
@@ -0,0 +1,69 @@
+#include <type_traits>
+
+#include <engine/component.h>
+#include <engine/transform.h>
+#include <engine/world_arena.h>
+#include <graphics/sprite.h>
+#include <gtest/gtest.h>
+
+#include "maths/vec2.h"
+
+using Vec2fManager = core::ComponentManager<core::Vec2f, 2u>;
+static_assert(!std::is_copy_constructible_v<Vec2fManager> && !std::is_copy_assignable_v<Vec2fManager>);
+static_assert(!std::is_move_constructible_v<Vec2fManager> && !std::is_move_assignable_v<Vec2fManager>);
+static_assert(!std::is_copy_constructible_v<core::TransformManager> && !std::is_move_constructible_v<core::TransformManager>);
+static_assert(!std::is_copy_constructible_v<core::SpriteManager> && !std::is_move_constructible_v<core::SpriteManager>);
+
+TEST(WorldArena, CopyComponents)
+{
+    core::EntityManager entityManager;
+    core::WorldArena arena(core::WorldArena::GetAllocationSize<core::Vec2f>(entityManager.GetEntitiesSize()));
+    core::WorldArena otherArena(arena.GetCapacity());
+    core::ComponentManager<core::Vec2f, 2u> componentManager(entityManager, arena);
+    core::ComponentManager<core::Vec2f, 2u> otherComponentManager(entityManager, otherArena);
+    EXPECT_EQ(componentManager.GetAllComponents().size(), entityManager.GetEntitiesSize());
+    EXPECT_EQ(arena.GetSize(), otherArena.GetSize());
+
+    const auto entity = entityManager.CreateEntity();
+    componentManager.AddComponent(entity);
+    componentManager.SetComponent(entity, core::Vec2f(1.0f, 2.0f));
+    otherArena.CopyFrom(arena);
+    EXPECT_EQ(otherComponentManager.GetComponent(entity), core::Vec2f(1.0f, 2.0f));
+
+    componentManager.SetComponent(entity, core::Vec2f::zero());
+    EXPECT_TRUE(arena.SetBytes(otherArena.GetBytes()));
+    EXPECT_EQ(componentManager.GetComponent(entity), core::Vec2f(1.0f, 2.0f));
+}
+
+TEST(WorldArena, SpawnPastCapacity)
+{
+    constexpr std::size_t capacity = 2;
+    core::EntityManager entityManager(capacity);
+    core::WorldArena arena(core::WorldArena::GetAllocationSize<core::Vec2f>(capacity));
+    core::ComponentManager<core::Vec2f, 2u> componentManager(entityManager, arena);
+    EXPECT_TRUE(entityManager.IsCapacityFixed());
+
+    for (std::size_t i = 0; i < capacity; i++)
+    {
+        const auto entity = entityManager.CreateEntity();
+        ASSERT_NE(entity, core::EntityManager::INVALID_ENTITY);
+        componentManager.AddComponent(entity);
+    }
+    EXPECT_EQ(entityManager.CreateEntity(), core::EntityManager::INVALID_ENTITY);
+    EXPECT_EQ(entityManager.GetEntitiesSize(), capacity);
+    EXPECT_EQ(componentManager.GetAllComponents().size(), capacity);
+}
+
+TEST(WorldArena, CopyOtherCount)
+{
+    core::EntityManager entityManager;
+    core::WorldArena arena(core::WorldArena::GetAllocationSize<core::Vec2f>(entityManager.GetEntitiesSize()));
+    Vec2fManager componentManager(entityManager, arena);
+    const std::vector<core::Vec2f> components(entityManager.GetEntitiesSize() - 1, core::Vec2f::one());
+    EXPECT_FALSE(componentManager.CopyAllComponents(components));
+    EXPECT_EQ(componentManager.GetComponent(0), core::Vec2f::zero());
+
+    const std::vector<core::Vec2f> allComponents(entityManager.GetEntitiesSize(), core::Vec2f::one());
+    EXPECT_TRUE(componentManager.CopyAllComponents(allComponents));
+    EXPECT_EQ(componentManager.GetComponent(0), core::Vec2f::one());
+}
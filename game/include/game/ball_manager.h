@@ -1,6 +1,7 @@
 #pragma once
 #include <SFML/System/Time.hpp>
 #include <maths/vec2.h>
+#include <maths/random.h>
 #include "game_pong_globals.h"
 #include "physics_pong_manager.h"
 
@@ -23,14 +24,26 @@ namespace game
     class BallManager : public core::ComponentManager<Ball, static_cast<core::EntityMask>(ComponentType::BALL)>
     {
     public:
-        explicit BallManager(core::EntityManager& entityManager,
+        BallManager(core::EntityManager& entityManager,
+            core::WorldArena& arena,
             GameManager& gameManager,
             PhysicsManager& physicsManager,
-            PlayerCharacterManager& playerCharacterManager);
+            PlayerCharacterManager& playerCharacterManager,
+            core::Rng& rng);
         void FixedUpdate(sf::Time dt);
+        /**
+         * \brief Maximum angle between the serve direction and the horizontal
+         */
+        static constexpr float maxServeAngle = 45.0f;
     private:
+        /**
+         * \brief Puts the ball back at the center, same speed and horizontal direction with a random angle
+         */
+        void Serve(Body& ball);
+
         GameManager& gameManager_;
         PhysicsManager& physicsManager_;
         PlayerCharacterManager& playerCharacterManager_;
+        core::Rng& rng_;
     };
 }
@@ -31,6 +31,16 @@ namespace game
     const float playerInvincibilityPeriod = 1.5f;
     const float invincibilityFlashPeriod = 0.5f;
 
+    /**
+     * \brief Number of entities the managers of a match are sized for up front. With lockDuringSimulation, growing
+     * them while simulating or validating frames asserts, a reallocation there would stall every resimulated frame.
+     */
+    struct WorldCapacity
+    {
+        std::size_t entityCount = core::entityInitNmb;
+        bool lockDuringSimulation = true;
+    };
+
     const std::array<sf::Color, std::max(maxPlayerNmb, 5u)> playerColors =
     {
       {
@@ -5,9 +5,12 @@
 #include "game_pong_globals.h"
 #include "pong_rollback_manager.h"
 #include "pong_background.h"
+#include "engine/clock.h"
 #include "engine/entity.h"
 #include "graphics/graphics.h"
+#include "graphics/render_snapshot.h"
 #include "graphics/sprite.h"
+#include "graphics/texture_atlas.h"
 #include "engine/system.h"
 #include "engine/transform.h"
 #include "network/pong_packet_type.h"
@@ -15,6 +18,7 @@
 namespace game
 {
     class PacketSenderInterface;
+    class ReplayRecorder;
 
     /**
      * \brief Manages the game, shared between the client and the server
@@ -22,7 +26,7 @@ namespace game
     class GameManager
     {
     public:
-        GameManager();
+        explicit GameManager(const WorldCapacity& capacity = {});
         virtual ~GameManager() = default;
         virtual void SpawnPlayer(PlayerNumber playerNumber, core::Vec2f position, core::degree_t rotation);
         virtual core::Entity SpawnBall(PlayerNumber, core::Vec2f position, core::Vec2f velocity);
@@ -41,10 +45,30 @@ namespace game
          */
         void Validate(Frame newValidateFrame);
         void CopyAllComponents(const GameManager& gameManager);
+        /**
+         * \brief Records the spawns and validated inputs into replayRecorder, nullptr stops the recording
+         */
+        void SetReplayRecorder(ReplayRecorder* replayRecorder) { replayRecorder_ = replayRecorder; }
+        /**
+         * \brief Replaces the validated game state, used to seek in replays
+         */
+        bool RestoreValidateState(const RollbackState& state) { return rollbackManager_.RestoreValidateState(state); }
+        /**
+         * \brief Seed of the simulation random generator, sent by the server with the start of the game
+         */
+        void SetRandomSeed(std::uint32_t seed);
         static constexpr float PixelPerUnit = 100.0f;
         static constexpr float FixedPeriod = 0.02f; //50fps
         PlayerNumber CheckWinner() const;
+        /**
+         * \brief Winner declared by WinGame, INVALID_PLAYER while the match is running
+         */
+        [[nodiscard]] PlayerNumber GetWinner() const { return winner_; }
         virtual void WinGame(PlayerNumber winner);
+        /**
+         * \brief Adds the memory of the managers of the match to report, the sum is the memory cost of one match
+         */
+        virtual void GetMemoryReport(core::MemoryReport& report) const;
     protected:
         core::EntityManager entityManager_;
         core::TransformManager transformManager_;
@@ -53,10 +77,12 @@ namespace game
         std::array<core::Entity, maxPlayerNmb> playerEntityMap_{};
         Frame currentFrame_ = 0;
         PlayerNumber winner_ = INVALID_PLAYER;
+        ReplayRecorder* replayRecorder_ = nullptr;
     };
 
     class ClientGameManager : public GameManager,
-        public core::DrawInterface, public core::DrawImGuiInterface, public core::SystemInterface
+        public core::DrawInterface, public core::DrawImGuiInterface, public core::SystemInterface,
+        public core::RenderSnapshotInterface
     {
     public:
         enum State : std::uint32_t
@@ -64,14 +90,26 @@ namespace game
             STARTED = 1u << 0u,
             FINISHED = 1u << 1u,
         };
-        explicit ClientGameManager(PacketSenderInterface& packetSenderInterface);
+        explicit ClientGameManager(PacketSenderInterface& packetSenderInterface, const WorldCapacity& capacity = {});
         void StartGame(unsigned long long int startingTime);
         void Init() override;
         void Update(sf::Time dt) override;
+        /**
+         * \brief Steps the game by exactly one fixed period without rendering work, so it can run as fast as the CPU allows
+         */
+        void Tick();
         void Destroy() override;
+        /**
+         * \brief Time source used to start the game, the clock has to outlive the game manager
+         */
+        void SetClock(const core::ClockInterface& clock) { clock_ = &clock; }
         void SetWindowSize(sf::Vector2u windowsSize);
         [[nodiscard]] sf::Vector2u GetWindowSize() const { return windowSize_; }
         void Draw(sf::RenderTarget& target) override;
+        /**
+         * \brief Copies the sprites and the HUD texts of the current frame, Draw goes through it too
+         */
+        void WriteRenderSnapshot(core::RenderSnapshot& snapshot) override;
         void SetClientPlayer(PlayerNumber clientPlayer);
         void SpawnPlayer(PlayerNumber playerNumber, core::Vec2f position, core::degree_t rotation) override;
         core::Entity SpawnBall(PlayerNumber playerNumber, core::Vec2f position, core::Vec2f velocity) override;
@@ -81,10 +119,20 @@ namespace game
         void ConfirmValidateFrame(Frame newValidateFrame, const std::array<PhysicsState, maxPlayerNmb>& physicsStates);
         [[nodiscard]] PlayerNumber GetPlayerNumber() const { return clientPlayer_; }
         void WinGame(PlayerNumber winner) override;
+        void GetMemoryReport(core::MemoryReport& report) const override;
         [[nodiscard]] std::uint32_t GetState() const { return state_; }
     protected:
 
         void UpdateCameraView();
+        /**
+         * \brief Sets the rendered positions between the two last simulated frames using the fixed timer remainder
+         */
+        void InterpolatePositions();
+        /**
+         * \brief Decays the visual offsets and adds the corrections of the last resimulation to them,
+         * so corrected entities move smoothly to their new position instead of popping
+         */
+        void UpdateVisualOffsets(sf::Time dt);
 
         PacketSenderInterface& packetSenderInterface_;
         sf::Vector2u windowSize_;
@@ -93,15 +141,38 @@ namespace game
         PlayerNumber clientPlayer_ = INVALID_PLAYER;
         core::SpriteManager spriteManager_;
         PongBackground pongBackground_;
+        const core::ClockInterface* clock_ = &core::SystemClock::Get();
         float fixedTimer_ = 0.0f;
+        /**
+         * \brief Simulated positions of the frame before interpolatedFrame_ and of interpolatedFrame_
+         */
+        std::vector<core::Vec2f> previousPositions_;
+        std::vector<core::Vec2f> currentPositions_;
+        Frame interpolatedFrame_ = 0;
+        bool interpolationEnabled_ = true;
+        /**
+         * \brief Moves bigger than this in one frame are not interpolated
+         */
+        static constexpr float interpolationSnapDistance = 0.5f;
+        /**
+         * \brief Rendered position minus simulated position of each entity, decaying to zero
+         */
+        std::vector<core::Vec2f> visualOffsets_;
+        bool visualSmoothingEnabled_ = true;
+        /**
+         * \brief Time for a visual offset to decay by a factor of e
+         */
+        static constexpr float visualSmoothingTime = 0.1f;
+        static constexpr float visualSmoothingSnapDistance = 1.0f;
+        static constexpr float visualOffsetEpsilon = 0.001f;
         unsigned long long startingTime_ = 0;
         std::uint32_t state_ = 0;
 
-        sf::Texture paletteTexture_;
-        sf::Texture ballTexture_;
-        sf::Texture pongBg_;
+        core::TextureAtlas spriteAtlas_;
         sf::Font font_;
 
-        sf::Text textRenderer_;
+        core::RenderSnapshot renderSnapshot_;
+        core::SpriteBatch spriteBatch_;
+        core::MemoryReport memoryReport_;
     };
 }
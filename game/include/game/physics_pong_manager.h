@@ -5,6 +5,7 @@
 #include "engine/entity.h"
 #include "maths/angle.h"
 #include "maths/vec2.h"
+#include "maths/vec2_batch.h"
 #include <SFML/System/Time.hpp>
 #include "utils/action_utility.h"
 
@@ -29,6 +30,15 @@ namespace game
         bool isTrigger = false;
     };
 
+    /**
+     * \brief Overlapping pair of colliders found by the physics step, entity1 < entity2
+     */
+    struct Contact
+    {
+        core::Entity entity1 = core::EntityManager::INVALID_ENTITY;
+        core::Entity entity2 = core::EntityManager::INVALID_ENTITY;
+    };
+
     class OnTriggerInterface
     {
     public:
@@ -50,8 +60,19 @@ namespace game
     class PhysicsManager
     {
     public:
-        explicit PhysicsManager(core::EntityManager& entityManager);
+        /**
+         * \brief The bodies and the boxes are allocated in arena with the rest of the simulation state
+         */
+        PhysicsManager(core::EntityManager& entityManager, core::WorldArena& arena);
+        /**
+         * \brief Moves the bodies, then fills the contact buffer with the overlapping colliders in entity order.
+         * The contacts are not resolved here, the trigger listeners are called once the buffer is complete.
+         */
         void FixedUpdate(sf::Time dt);
+        /**
+         * \brief Contacts of the last FixedUpdate, valid until the next one
+         */
+        [[nodiscard]] const std::vector<Contact>& GetContacts() const { return contacts_; }
         [[nodiscard]] const Body& GetBody(core::Entity entity) const;
         void SetBody(core::Entity entity, const Body& body);
         void AddBody(core::Entity entity);
@@ -61,11 +82,30 @@ namespace game
 
         void RegisterTriggerListener(OnTriggerInterface& collisionInterface);
         void CopyAllComponents(const PhysicsManager& physicsManager);
+        [[nodiscard]] std::span<const Body> GetAllBodies() const { return bodyManager_.GetAllComponents(); }
+        [[nodiscard]] std::span<const Box> GetAllBoxes() const { return boxManager_.GetAllComponents(); }
+        /**
+         * \brief False without copying anything if the counts differ from the bodies and the boxes of the manager
+         */
+        bool CopyAllComponents(std::span<const Body> bodies, std::span<const Box> boxes);
+        /**
+         * \brief Adds the bodies, the boxes and the narrow phase buffers to report
+         */
+        void GetMemoryReport(core::MemoryReport& report, std::string_view subsystem) const;
     private:
         core::EntityManager& entityManager_;
         BodyManager bodyManager_;
         BoxManager boxManager_;
         core::Action<core::Entity, core::Entity> onTriggerAction_;
+
+        static constexpr std::size_t contactInitNmb = 64;
+        /**
+         * \brief Reused between the steps so the narrow phase does not allocate
+         */
+        std::vector<Contact> contacts_;
+        std::vector<core::Entity> colliderEntities_;
+        std::vector<core::Aabb> colliderBoxes_;
+        std::vector<std::uint8_t> overlaps_;
     };
 
 }
@@ -1,7 +1,12 @@
 #pragma once
+#include <cstdint>
+#include <vector>
+
 #include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
 
 #include "graphics/graphics.h"
+#include "maths/random.h"
 
 namespace sf
 {
@@ -11,14 +16,25 @@ class RenderTarget;
 namespace game
 {
 
+/**
+ * \brief Star field generated once from a seed and uploaded to a static vertex buffer,
+ * drawn from the vertices in memory when vertex buffers are not available
+ */
 class PongBackground : public core::DrawInterface
 {
 public:
-    void Init();
+    void Init(std::uint64_t seed = core::Rng::defaultSeed);
     void Draw(sf::RenderTarget& window) override;
+    /**
+     * \brief Static vertex buffer, or the vertices in memory when vertex buffers are not available.
+     * Added to the render snapshots, it stays valid until the next Init.
+     */
+    [[nodiscard]] const sf::Drawable& GetDrawable() const;
+    [[nodiscard]] bool IsInitialized() const { return vertices_.getVertexCount() > 0; }
 private:
     static constexpr std::size_t starCount = 1024;
-    sf::VertexArray vertexArray_;
+    sf::VertexArray vertices_{ sf::Points };
+    sf::VertexBuffer vertexBuffer_{ sf::Points, sf::VertexBuffer::Static };
 };
 
 }
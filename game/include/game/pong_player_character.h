@@ -21,7 +21,7 @@ namespace game
     class PlayerCharacterManager : public core::ComponentManager<PlayerCharacter, core::EntityMask(ComponentType::PLAYER_CHARACTER)>
     {
     public:
-        explicit PlayerCharacterManager(core::EntityManager& entityManager, PhysicsManager& physicsManager, GameManager& gameManager);
+        PlayerCharacterManager(core::EntityManager& entityManager, core::WorldArena& arena, PhysicsManager& physicsManager, GameManager& gameManager);
         void FixedUpdate(sf::Time dt);
 
     private:
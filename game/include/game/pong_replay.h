@@ -0,0 +1,178 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "game_pong_globals.h"
+#include "game_pong_manager.h"
+#include "maths/vec2.h"
+#include "network/pong_packet_type.h"
+#include "utils/mapped_file.h"
+#include "utils/memory.h"
+
+namespace game
+{
+    /**
+     * \brief Spawn data and final validated state of one player in a replay
+     */
+    struct ReplayPlayerData
+    {
+        core::Vec2f position;
+        float rotation = 0.0f;
+        PhysicsState finalPhysicsState = 0;
+        std::uint16_t padding = 0;
+    };
+
+    /**
+     * \brief Fixed size header at the start of a replay file, followed by the packed inputs, the keyframes and
+     * the keyframe index
+     */
+    struct ReplayHeader
+    {
+        std::array<char, 4> magic{};
+        std::uint16_t version = 0;
+        std::uint8_t playerCount = 0;
+        PlayerNumber winner = INVALID_PLAYER;
+        /**
+         * \brief Number of validated frames, inputs are stored from frame 1 to frameCount
+         */
+        Frame frameCount = 0;
+        core::Vec2f ballPosition;
+        core::Vec2f ballVelocity;
+        std::array<ReplayPlayerData, maxPlayerNmb> players{};
+        std::uint32_t keyframeCount = 0;
+        /**
+         * \brief Seed of the simulation random generator
+         */
+        std::uint32_t seed = 0;
+        /**
+         * \brief Offset in the file of the keyframe index, an array of keyframeCount ReplayKeyframeEntry
+         */
+        std::uint64_t indexOffset = 0;
+    };
+    static_assert(std::is_trivially_copyable_v<ReplayHeader>, "Replay header is written as raw bytes");
+    static_assert(sizeof(ReplayHeader) == 80, "Replay header must not contain implicit padding");
+
+    /**
+     * \brief Keyframe index entry, sorted by frame
+     */
+    struct ReplayKeyframeEntry
+    {
+        Frame frame = 0;
+        std::uint32_t size = 0;
+        std::uint64_t offset = 0;
+    };
+    static_assert(sizeof(ReplayKeyframeEntry) == 16, "Keyframe entry must not contain implicit padding");
+
+    constexpr std::array<char, 4> replayMagic = { 'P', 'R', 'P', 'L' };
+    constexpr std::uint16_t replayVersion = 3;
+    /**
+     * \brief Minimum number of frames between two keyframes, keyframes are taken on the server validated frames
+     */
+    constexpr Frame replayKeyframeInterval = 10 * 50;
+    /**
+     * \brief Only the UP and DOWN bits of a PlayerInput are stored
+     */
+    constexpr std::uint32_t replayInputBits = 2;
+    constexpr PlayerInput replayInputMask = (1u << replayInputBits) - 1u;
+
+    [[nodiscard]] std::size_t GetReplayInputsSize(Frame frameCount);
+    [[nodiscard]] PlayerInput UnpackReplayInput(const std::uint8_t* packedInputs, PlayerNumber playerNumber, Frame frame);
+
+    /**
+     * \brief Records the spawns and the validated inputs of a GameManager, attached with GameManager::SetReplayRecorder
+     */
+    class ReplayRecorder
+    {
+    public:
+        ReplayRecorder();
+        void RecordPlayerSpawn(PlayerNumber playerNumber, core::Vec2f position, core::degree_t rotation);
+        void RecordBallSpawn(core::Vec2f position, core::Vec2f velocity);
+        void RecordRandomSeed(std::uint32_t seed);
+        /**
+         * \brief Frames have to be recorded in order, starting at frame 1
+         */
+        void RecordInputs(Frame frame, const std::array<PlayerInput, maxPlayerNmb>& inputs);
+        /**
+         * \brief Takes a keyframe of the validated state if the last one is older than replayKeyframeInterval
+         */
+        void RecordValidateState(const RollbackManager& rollbackManager);
+        [[nodiscard]] Frame GetFrameCount() const { return header_.frameCount; }
+        [[nodiscard]] core::MemoryUsage GetMemoryUsage() const;
+        bool Save(const std::string& path, PlayerNumber winner,
+            const std::array<PhysicsState, maxPlayerNmb>& finalPhysicsStates);
+        void Clear();
+    private:
+        ReplayHeader header_;
+        std::vector<std::uint8_t> packedInputs_;
+        /**
+         * \brief Serialized keyframes, the index offsets are relative to the start of this buffer until saved
+         */
+        std::vector<std::uint8_t> keyframes_;
+        std::vector<ReplayKeyframeEntry> keyframeIndex_;
+        RollbackState keyframeState_;
+    };
+
+    /**
+     * \brief Memory-mapped replay file, inputs and keyframes are read in place
+     */
+    class Replay
+    {
+    public:
+        bool Load(const std::string& path);
+        [[nodiscard]] const ReplayHeader& GetHeader() const { return header_; }
+        [[nodiscard]] PlayerInput GetInput(PlayerNumber playerNumber, Frame frame) const;
+        [[nodiscard]] const std::vector<ReplayKeyframeEntry>& GetKeyframeIndex() const { return keyframeIndex_; }
+        /**
+         * \brief Returns the last keyframe at or before frame, nullptr if there is none
+         */
+        [[nodiscard]] const ReplayKeyframeEntry* FindKeyframe(Frame frame) const;
+        bool LoadKeyframe(const ReplayKeyframeEntry& keyframe, RollbackState& state) const;
+    private:
+        core::MappedFile file_;
+        ReplayHeader header_;
+        const std::uint8_t* packedInputs_ = nullptr;
+        std::vector<ReplayKeyframeEntry> keyframeIndex_;
+    };
+
+    /**
+     * \brief Feeds the recorded inputs to a GameManager as the server would, without any real time constraint
+     */
+    class ReplayPlayer
+    {
+    public:
+        explicit ReplayPlayer(const Replay& replay);
+        void Init();
+        /**
+         * \brief Validates the next frames of the replay, returns false when the replay is over
+         */
+        bool Update();
+        [[nodiscard]] bool IsOver() const;
+        /**
+         * \brief Moves to frame, restoring the nearest keyframe before it when going back or jumping far ahead
+         * and resimulating from there. False if the starting state does not fit the world capacity of the player.
+         */
+        bool Seek(Frame frame, bool useKeyframes = true);
+        [[nodiscard]] Frame GetCurrentFrame() const { return gameManager_.GetLastValidateFrame(); }
+        [[nodiscard]] const GameManager& GetGameManager() const { return gameManager_; }
+        /**
+         * \brief Checks the final physics states and the winner against the recorded ones
+         */
+        [[nodiscard]] bool IsMatchingRecord() const;
+        /**
+         * \brief Number of frames validated at once, must fit in the rollback input window
+         */
+        static constexpr Frame validateChunkSize = 50;
+    private:
+        void ValidateUntil(Frame frame);
+        void UpdateWinner();
+
+        const Replay& replay_;
+        GameManager gameManager_;
+        PlayerNumber winner_ = INVALID_PLAYER;
+        RollbackState initialState_;
+        RollbackState keyframeState_;
+    };
+}
@@ -3,8 +3,12 @@
 #include "game_pong_globals.h"
 #include "physics_pong_manager.h"
 #include "pong_player_character.h"
+#include "pong_rollback_metrics.h"
 #include "engine/entity.h"
+#include "engine/tick_budget.h"
 #include "engine/transform.h"
+#include "engine/world_arena.h"
+#include "maths/random.h"
 #include "network/pong_packet_type.h"
 
 
@@ -26,10 +30,32 @@ class GameManager;
         Frame destroyedFrame = 0;
     };
 
-    class RollbackManager : public OnTriggerInterface
+    /**
+     * \brief Copy of the rollback game state at a validated frame
+     */
+    struct RollbackState
+    {
+        Frame frame = 0;
+        std::vector<Body> bodies;
+        std::vector<Box> boxes;
+        std::vector<PlayerCharacter> playerCharacters;
+        std::vector<Ball> balls;
+        core::Rng rng;
+    };
+
+    /**
+     * \brief Contact between a player and a ball, sorted out of the physics contacts by type
+     */
+    struct PlayerBallContact
+    {
+        core::Entity playerEntity = core::EntityManager::INVALID_ENTITY;
+        core::Entity ballEntity = core::EntityManager::INVALID_ENTITY;
+    };
+
+    class RollbackManager
     {
     public:
-        explicit RollbackManager(GameManager& gameManager, core::EntityManager& entityManager);
+        RollbackManager(GameManager& gameManager, core::EntityManager& entityManager, const WorldCapacity& capacity);
         /**
          * \brief Simulate all players with new inputs, method call only by the clients
          */
@@ -45,9 +71,50 @@ class GameManager;
          */
         void ConfirmFrame(Frame newValidatedFrame, const std::array<PhysicsState, maxPlayerNmb>& serverPhysicsState);
         [[nodiscard]] PhysicsState GetValidatePhysicsState(PlayerNumber playerNumber) const;
+        /**
+         * \brief Seeds the random generator of the simulation, must be the same on the server and the clients
+         */
+        void SetRandomSeed(std::uint64_t seed);
+        void GetValidateState(RollbackState& state) const;
+        /**
+         * \brief Replaces the validated and current game states and drops all the inputs, used to seek in replays.
+         * False without changing anything if the component counts of state do not match the world capacity.
+         */
+        bool RestoreValidateState(const RollbackState& state);
+        /**
+         * \brief Validated bodies, boxes, players, balls and random generator as one contiguous block
+         */
+        [[nodiscard]] std::span<const std::byte> GetValidateWorldState() const { return lastValidateArena_.GetBytes(); }
+        /**
+         * \brief Same as RestoreValidateState from a block returned by GetValidateWorldState of a rollback manager
+         * with the same world capacity, false if the block does not match the layout
+         */
+        bool RestoreValidateWorldState(std::span<const std::byte> worldState, Frame frame);
         [[nodiscard]] Frame GetLastValidateFrame() const { return lastValidateFrame_; }
         [[nodiscard]] Frame GetLastReceivedFrame(PlayerNumber playerNumber) const { return lastReceivedFrame_[playerNumber]; }
         [[nodiscard]] Frame GetCurrentFrame() const { return currentFrame_; }
+        /**
+         * \brief Number of player physics states that did not match the server ones when confirming frames
+         */
+        [[nodiscard]] std::uint32_t GetDesyncCount() const { return desyncCount_; }
+        /**
+         * \brief Frame simulated by the previous SimulateToCurrentFrame call, INVALID_FRAME if the last call could not
+         * resimulate it. Its bodies as resimulated by the last call are in GetResimulatedBodies, the difference with
+         * the previous result is the correction of a misprediction.
+         */
+        [[nodiscard]] Frame GetResimulatedFrame() const { return resimulatedFrame_; }
+        [[nodiscard]] const std::vector<Body>& GetResimulatedBodies() const { return resimulatedBodies_; }
+        [[nodiscard]] RollbackMetrics& GetMetrics() { return metrics_; }
+        [[nodiscard]] const RollbackMetrics& GetMetrics() const { return metrics_; }
+        /**
+         * \brief Splits FixedPeriod / maxRollbackDepth evenly between the simulation systems, so a full rollback of
+         * maxRollbackDepth frames fits in one fixed period when no system overruns
+         */
+        void SetTickBudget(Frame maxRollbackDepth);
+        [[nodiscard]] core::TickBudgetTracker& GetTickBudget() { return tickBudget_; }
+        [[nodiscard]] const core::TickBudgetTracker& GetTickBudget() const { return tickBudget_; }
+        static constexpr Frame defaultBudgetRollbackDepth = 25;
+        static constexpr Frame INVALID_FRAME = std::numeric_limits<Frame>::max();
         [[nodiscard]] core::TransformManager& GetTransformManager() { return currentTransformManager_; }
         [[nodiscard]] const PlayerCharacterManager& GetPlayerCharacterManager() const { return currentPlayerManager_; }
         void SpawnPlayer(PlayerNumber playerNumber, core::Entity entity, core::Vec2f position, core::degree_t rotation);
@@ -57,11 +124,45 @@ class GameManager;
          */
         void DestroyEntity(core::Entity entity);
 
-        void OnTrigger(core::Entity entity1, core::Entity entity2) override;
+        [[nodiscard]] PlayerInput GetInputAtFrame(PlayerNumber playerNumber, Frame frame) const;
+        /**
+         * \brief Adds the current and the last validated game states and the input window to report
+         */
+        void GetMemoryReport(core::MemoryReport& report) const;
     private:
-        PlayerInput GetInputAtFrame(PlayerNumber playerNumber, Frame frame);
+        /**
+         * \brief Simulates one frame of the current game state, timing each system against its tick budget
+         */
+        void FixedUpdateSystems();
+        /**
+         * \brief Sorts the contacts of the last physics step by type, then applies the responses type by type
+         */
+        void ResolveContacts();
+        /**
+         * \brief Sends the ball back toward the opponent of player
+         */
+        void ManageCollision(const PlayerCharacter& player, core::Entity ballEntity);
+        /**
+         * \brief Resets the frames, the inputs and the created entities after the validated state was replaced
+         */
+        void OnValidateStateRestored(Frame frame);
+        /**
+         * \brief Bytes of the arena holding the simulation state of entityCount entities
+         */
+        [[nodiscard]] static std::size_t GetWorldArenaSize(std::size_t entityCount);
         GameManager& gameManager_;
         core::EntityManager& entityManager_;
+        /**
+         * \brief Simulation state of the current and last validated game states, rolling back is one arena copy.
+         * Both are allocated in the same order so they share the same layout.
+         */
+        core::WorldArena currentArena_;
+        core::WorldArena lastValidateArena_;
+        /**
+         * \brief Random generators of the current and last validated game states, rolled back with the components
+         */
+        core::Rng& currentRng_;
+        core::Rng& lastValidateRng_;
         /**
          * \brief Used for rendering
          */
@@ -81,15 +182,34 @@ class GameManager;
         Frame lastValidateFrame_ = 0; //Confirm frame
         Frame currentFrame_ = 0;
         Frame testedFrame_ = 0;
+        std::uint32_t desyncCount_ = 0;
+        bool lockCapacity_ = true;
+        Frame lastSimulatedFrame_ = INVALID_FRAME;
+        Frame resimulatedFrame_ = INVALID_FRAME;
+        std::vector<Body> resimulatedBodies_;
+        RollbackMetrics metrics_;
+        core::TickBudgetTracker tickBudget_;
+        core::TickBudgetTracker::SystemId frameTickId_ = 0;
+        core::TickBudgetTracker::SystemId ballTickId_ = 0;
+        core::TickBudgetTracker::SystemId playerTickId_ = 0;
+        core::TickBudgetTracker::SystemId physicsTickId_ = 0;
+        core::TickBudgetTracker::SystemId contactsTickId_ = 0;
 
         static constexpr std::size_t windowBufferSize = 5 * 50; // 5 seconds of frame at 50 fps
         std::array<std::uint32_t, maxPlayerNmb> lastReceivedFrame_{};
         std::array<std::array<PlayerInput, windowBufferSize>, maxPlayerNmb> inputs_{};
+        /**
+         * \brief Last prediction used for the frames simulated before their input was received, indexed by
+         * frame modulo windowBufferSize. predictedFrames_ holds the frame of the prediction, INVALID_FRAME once checked.
+         */
+        std::array<std::array<PlayerInput, windowBufferSize>, maxPlayerNmb> predictedInputs_{};
+        std::array<std::array<Frame, windowBufferSize>, maxPlayerNmb> predictedFrames_{};
         /**
          * \brief Array containing all the created entities in the window between the confirm frame and the current frame
          * to destroy them when rollbacking.
          */
         std::vector<CreatedEntity> createdEntities_;
+        std::vector<PlayerBallContact> playerBallContacts_;
     public:
         [[nodiscard]] const std::array<PlayerInput, windowBufferSize>& GetInputs(PlayerNumber playerNumber) const
         {
@@ -0,0 +1,78 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+
+#include "game_pong_globals.h"
+
+namespace game
+{
+    /**
+     * \brief Statistics of the client resimulations, filled by the RollbackManager
+     */
+    class RollbackMetrics
+    {
+    public:
+        /**
+         * \brief The last bucket of the depth histogram counts all the deeper rollbacks
+         */
+        static constexpr std::size_t depthHistogramSize = 16;
+        /**
+         * \brief Called after each SimulateToCurrentFrame with the number of frames resimulated from the validated state
+         */
+        void RecordSimulation(Frame depth, sf::Time duration);
+        /**
+         * \brief A remote input was not received when its frame was simulated for the first time
+         */
+        void RecordPredictedInput() { predictedInputCount_++; }
+        /**
+         * \brief The real input of a predicted frame was received
+         */
+        void RecordPredictionResult(bool mispredicted);
+        void Reset();
+
+        [[nodiscard]] std::uint64_t GetSimulationCount() const { return simulationCount_; }
+        [[nodiscard]] Frame GetLastDepth() const { return lastDepth_; }
+        [[nodiscard]] Frame GetMaxDepth() const { return maxDepth_; }
+        [[nodiscard]] float GetAverageDepth() const;
+        [[nodiscard]] const std::array<std::uint64_t, depthHistogramSize>& GetDepthHistogram() const { return depthHistogram_; }
+        /**
+         * \brief Frames resimulated during the last complete second
+         */
+        [[nodiscard]] float GetResimulatedFramesPerSecond() const { return resimulatedFramesPerSecond_; }
+        [[nodiscard]] std::uint64_t GetPredictedInputCount() const { return predictedInputCount_; }
+        [[nodiscard]] std::uint64_t GetMispredictedInputCount() const { return mispredictedInputCount_; }
+        /**
+         * \brief Ratio of the checked predicted inputs that were wrong, between 0 and 1
+         */
+        [[nodiscard]] float GetMispredictionRate() const;
+        [[nodiscard]] sf::Time GetLastSimulationTime() const { return lastSimulationTime_; }
+        [[nodiscard]] sf::Time GetAverageSimulationTime() const;
+        [[nodiscard]] sf::Time GetMaxSimulationTime() const { return maxSimulationTime_; }
+        /**
+         * \brief Average time to simulate one frame, the cost a rollback pays per frame of depth
+         */
+        [[nodiscard]] sf::Time GetAverageFrameSimulationTime() const;
+        void DrawImGui();
+    private:
+        std::uint64_t simulationCount_ = 0;
+        std::uint64_t resimulatedFrameCount_ = 0;
+        Frame lastDepth_ = 0;
+        Frame maxDepth_ = 0;
+        std::array<std::uint64_t, depthHistogramSize> depthHistogram_{};
+
+        sf::Clock secondClock_;
+        std::uint64_t secondFrameCount_ = 0;
+        float resimulatedFramesPerSecond_ = 0.0f;
+
+        std::uint64_t predictedInputCount_ = 0;
+        std::uint64_t checkedPredictionCount_ = 0;
+        std::uint64_t mispredictedInputCount_ = 0;
+
+        sf::Time lastSimulationTime_;
+        sf::Time maxSimulationTime_;
+        sf::Time simulationTimeSum_;
+    };
+}
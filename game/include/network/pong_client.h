@@ -5,7 +5,8 @@
 
 namespace game
 {
-    class Client : public core::DrawInterface, public core::DrawImGuiInterface, public PacketSenderInterface, public core::SystemInterface
+    class Client : public core::DrawInterface, public core::DrawImGuiInterface, public PacketSenderInterface, public core::SystemInterface,
+        public core::RenderSnapshotInterface
     {
     public:
         Client() : gameManager_(*this)
@@ -18,6 +19,14 @@ namespace game
             gameManager_.SetWindowSize(windowSize);
         }
         virtual void ReceivePacket(const Packet* packet);
+        void WriteRenderSnapshot(core::RenderSnapshot& snapshot) override
+        {
+            gameManager_.WriteRenderSnapshot(snapshot);
+        }
+        void SetClock(const core::ClockInterface& clock) { gameManager_.SetClock(clock); }
+        void SetClientId(ClientId clientId) { clientId_ = clientId; }
+        [[nodiscard]] ClientId GetClientId() const { return clientId_; }
+        [[nodiscard]] const ClientGameManager& GetGameManager() const { return gameManager_; }
     protected:
 
         ClientGameManager gameManager_;
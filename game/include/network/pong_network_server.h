@@ -47,6 +47,10 @@ namespace game
         void ReceivePacket(sf::Packet& packet, PacketSocketSource packetSource,
             sf::IpAddress address = "localhost",
             unsigned short port = 0);
+        /**
+         * \brief Player whose UDP endpoint is address and port, INVALID_PLAYER before its UDP join packet
+         */
+        [[nodiscard]] PlayerNumber FindUdpPlayer(const sf::IpAddress& address, unsigned short port) const;
 
         enum ServerStatus
         {
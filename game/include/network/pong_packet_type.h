@@ -17,6 +17,7 @@ namespace game
         START_GAME,
         JOIN_ACK,
         WIN_GAME,
+        PING,
         NONE,
     };
 
@@ -157,18 +158,21 @@ namespace game
     struct StartGamePacket : TypedPacket<PacketType::START_GAME>
     {
         std::array<std::uint8_t, sizeof(unsigned long long)> startTime{};
-
+        /**
+         * \brief Seed of the simulation random generator, identical on all peers
+         */
+        std::array<std::uint8_t, sizeof(std::uint32_t)> seed{};
     };
 
 
     inline sf::Packet& operator<<(sf::Packet& packet, const StartGamePacket& startGamePacket)
     {
-        return packet << startGamePacket.startTime;
+        return packet << startGamePacket.startTime << startGamePacket.seed;
     }
 
     inline sf::Packet& operator>>(sf::Packet& packet, StartGamePacket& startGamePacket)
     {
-        return packet >> startGamePacket.startTime;
+        return packet >> startGamePacket.startTime >> startGamePacket.seed;
     }
 
     struct ValidateFramePacket : TypedPacket<PacketType::VALIDATE_STATE>
@@ -202,6 +206,25 @@ namespace game
         return packet >> winGamePacket.winner;
     }
 
+    /**
+     * \brief UDP Packet sent by the server to measure the round trip time, the clients send it back with their player number
+     */
+    struct PingPacket : TypedPacket<PacketType::PING>
+    {
+        PlayerNumber playerNumber = INVALID_PLAYER;
+        std::array<std::uint8_t, sizeof(unsigned long long)> serverTime{};
+    };
+
+    inline sf::Packet& operator<<(sf::Packet& packet, const PingPacket& pingPacket)
+    {
+        return packet << pingPacket.playerNumber << pingPacket.serverTime;
+    }
+
+    inline sf::Packet& operator>>(sf::Packet& packet, PingPacket& pingPacket)
+    {
+        return packet >> pingPacket.playerNumber >> pingPacket.serverTime;
+    }
+
     inline void GeneratePacket(sf::Packet& packet, Packet& sendingPacket)
     {
         packet << sendingPacket;
@@ -249,6 +272,12 @@ namespace game
             packet << packetTmp;
             break;
         }
+        case PacketType::PING:
+        {
+            auto& packetTmp = static_cast<PingPacket&>(sendingPacket);
+            packet << packetTmp;
+            break;
+        }
 
         default:;
         }
@@ -308,6 +337,13 @@ namespace game
             packet >> *winGamePacket;
             return winGamePacket;
         }
+        case PacketType::PING:
+        {
+            auto pingPacket = std::make_unique<PingPacket>();
+            pingPacket->packetType = packetTmp.packetType;
+            packet >> *pingPacket;
+            return pingPacket;
+        }
         default:;
         }
         return nullptr;
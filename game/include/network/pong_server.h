@@ -1,22 +1,66 @@
 #pragma once
 #include <memory>
+#include <string>
+#include <string_view>
 
 #include "game/game_pong_manager.h"
 #include "pong_packet_type.h"
+#include "engine/clock.h"
 #include "engine/system.h"
 #include "game/game_pong_globals.h"
+#include "game/pong_replay.h"
+#include "maths/random.h"
+#include "pong_server_metrics.h"
 
 namespace game
 {
     class Server : public PacketSenderInterface, public core::SystemInterface
     {
+    public:
+        /**
+         * \brief Time source used to schedule the game start, the clock has to outlive the server
+         */
+        void SetClock(const core::ClockInterface& clock) { clock_ = &clock; }
+        /**
+         * \brief Records the match and saves the replay to replayPath when a player wins, has to be set before players join
+         */
+        void SetReplayPath(std::string_view replayPath);
+        /**
+         * \brief Seed of the simulation random generator sent to the clients, random by default
+         */
+        void SetGameSeed(std::uint32_t gameSeed) { gameSeed_ = gameSeed; }
+        /**
+         * \brief Dumps the metrics in the Prometheus text format to metricsPath every metricsDumpPeriod, empty disables it
+         */
+        void SetMetricsPath(std::string_view metricsPath) { metricsPath_ = metricsPath; }
+        [[nodiscard]] const ServerMetrics& GetMetrics() const { return metrics_; }
+        /**
+         * \brief Refreshes the memory report of the match and writes the metrics to metricsPath
+         */
+        bool DumpMetrics();
+
+        static constexpr float pingPeriod = 1.0f;
+        static constexpr float metricsDumpPeriod = 5.0f;
     protected:
         virtual void SpawnNewPlayer(ClientId clientId, PlayerNumber playerNumber) = 0;
         virtual void ReceivePacket(std::unique_ptr<Packet> packet);
+        /**
+         * \brief Sends the pings, refreshes the validate lags and dumps the metrics when due, called by the server updates
+         */
+        void UpdateMetrics(sf::Time dt);
 
         //Server game manager
         GameManager gameManager_;
+        const core::ClockInterface* clock_ = &core::SystemClock::Get();
+        ReplayRecorder replayRecorder_;
+        std::string replayPath_;
+        std::uint32_t gameSeed_ = core::GetThreadRng().Next();
         PlayerNumber lastPlayerNumber_ = 0;
         std::array<ClientId, maxPlayerNmb> clientMap_{};
+        ServerMetrics metrics_;
+        core::MemoryReport memoryReport_;
+        std::string metricsPath_;
+        sf::Time pingTimer_;
+        sf::Time metricsDumpTimer_;
     };
 }
@@ -0,0 +1,100 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <SFML/System/Time.hpp>
+
+#include "game/game_pong_globals.h"
+#include "utils/memory.h"
+
+namespace game
+{
+    /**
+     * \brief Network counters of one connected client
+     */
+    struct ClientMetrics
+    {
+        std::uint64_t packetsIn = 0;
+        std::uint64_t bytesIn = 0;
+        std::uint64_t packetsOut = 0;
+        std::uint64_t bytesOut = 0;
+        std::uint64_t inputPacketsReceived = 0;
+        /**
+         * \brief Input packets missing from the frame sequence, a packet arriving late fills its gap back
+         */
+        std::uint64_t inputPacketsLost = 0;
+        Frame lastInputFrame = 0;
+        /**
+         * \brief Smoothed round trip time of the pings
+         */
+        sf::Time roundTripTime;
+        std::uint64_t pingCount = 0;
+        /**
+         * \brief Frames between the newest input received from any client and the last input of this client,
+         * the validation waits on the client with the largest lag
+         */
+        Frame validateLag = 0;
+    };
+
+    /**
+     * \brief Per-client and per-process counters of a server, exported in the Prometheus text format
+     */
+    class ServerMetrics
+    {
+    public:
+        /**
+         * \brief INVALID_PLAYER when the packet cannot be attributed to a client, it only counts in the process totals
+         */
+        void RecordPacketIn(PlayerNumber playerNumber, std::size_t bytes);
+        void RecordPacketOut(PlayerNumber playerNumber, std::size_t bytes);
+        void RecordInputPacket(PlayerNumber playerNumber, Frame inputFrame);
+        void RecordRoundTrip(PlayerNumber playerNumber, sf::Time roundTripTime);
+        void SetValidateLag(PlayerNumber playerNumber, Frame validateLag);
+        void SetValidateFrame(Frame validateFrame) { validateFrame_ = validateFrame; }
+        void RecordTick(sf::Time tickTime);
+        void RecordMatchStarted() { matchesStarted_++; }
+        void RecordMatchFinished() { matchesFinished_++; }
+        /**
+         * \brief Label added to all the samples to tell the server processes apart, e.g. their port
+         */
+        void SetInstance(std::string_view instance) { instance_ = instance; }
+        /**
+         * \brief Memory of the match managers, exported with the heap tags when memory tracking is compiled in
+         */
+        void SetMemoryReport(const core::MemoryReport& memoryReport) { memoryReport_ = memoryReport; }
+
+        [[nodiscard]] const ClientMetrics& GetClientMetrics(PlayerNumber playerNumber) const { return clients_[playerNumber]; }
+        /**
+         * \brief Tick time percentile over the last tickWindowSize ticks, percentile between 0 and 1
+         */
+        [[nodiscard]] sf::Time GetTickTimePercentile(float percentile) const;
+        [[nodiscard]] std::string WritePrometheus() const;
+        /**
+         * \brief Writes next to path then renames, a scraper never reads a partial file
+         */
+        bool DumpPrometheus(const std::string& path) const;
+
+        static constexpr std::size_t tickWindowSize = 1024;
+        /**
+         * \brief Weight of a new ping in the smoothed round trip time
+         */
+        static constexpr float roundTripSmoothing = 0.125f;
+    private:
+        std::array<ClientMetrics, maxPlayerNmb> clients_{};
+        std::uint64_t packetsIn_ = 0;
+        std::uint64_t bytesIn_ = 0;
+        std::uint64_t packetsOut_ = 0;
+        std::uint64_t bytesOut_ = 0;
+        std::uint64_t matchesStarted_ = 0;
+        std::uint64_t matchesFinished_ = 0;
+        Frame validateFrame_ = 0;
+
+        std::array<sf::Time, tickWindowSize> tickTimes_{};
+        std::uint64_t tickCount_ = 0;
+        sf::Time tickTimeSum_;
+        std::string instance_;
+        core::MemoryReport memoryReport_;
+    };
+}
@@ -14,6 +14,10 @@ namespace game
 
         void Init() override;
         void Update(sf::Time dt) override;
+        /**
+         * \brief Steps the client game by one fixed period, for headless simulation
+         */
+        void Tick();
 
         void Destroy() override;
         void Draw(sf::RenderTarget& window) override;
@@ -25,6 +29,10 @@ namespace game
 
         void DrawImGui() override;
         void SetPlayerInput(PlayerInput input);
+        /**
+         * \brief Sends the join packet to the server, the client id has to be set before
+         */
+        void Join();
         
     private:
         SimulationServer& server_;
@@ -1,16 +1,38 @@
 #pragma once
+#include <cstdint>
 #include <memory>
+#include <random>
+#include <vector>
 #include <SFML/System/Time.hpp>
 
 #include "pong_server.h"
 
 namespace game
 {
+	/**
+	 * \brief Packet waiting in a simulated network queue, delivered when the server time reaches deliveryTime
+	 */
 	struct DelayPacket
 	{
-		float currentTime = 0.0f;
+		double deliveryTime = 0.0;
+		std::uint64_t sequence = 0;
 		std::unique_ptr<game::Packet> packet = nullptr;
 	};
+
+	/**
+	 * \brief Orders the delay queues as min-heaps on delivery time, packets due at the same time keep their sending order
+	 */
+	struct DelayPacketCompare
+	{
+		bool operator()(const DelayPacket& a, const DelayPacket& b) const
+		{
+			if (a.deliveryTime != b.deliveryTime)
+			{
+				return a.deliveryTime > b.deliveryTime;
+			}
+			return a.sequence > b.sequence;
+		}
+	};
 	class SimulationClient;
 	class SimulationServer : public Server, public core::DrawImGuiInterface
 	{
@@ -23,18 +45,34 @@ namespace game
 		void PutPacketInReceiveQueue(std::unique_ptr<Packet> packet);
 		void SendReliablePacket(std::unique_ptr<Packet> packet) override;
 		void SendUnreliablePacket(std::unique_ptr<Packet> packet) override;
+		void SetDelay(float avgDelay, float marginDelay);
+		void SetSeed(std::uint32_t seed);
 	private:
 		void PutPacketInSendingQueue(std::unique_ptr<Packet> packet);
 		void ProcessReceivePacket(std::unique_ptr<Packet> packet);
+		void PushDelayPacket(std::vector<DelayPacket>& queue, std::unique_ptr<Packet> packet);
+		/**
+		 * \brief Pops the earliest packet of the queue if it is due, returns nullptr otherwise
+		 */
+		std::unique_ptr<Packet> PopDuePacket(std::vector<DelayPacket>& queue);
 
 		void SpawnNewPlayer(ClientId clientId, PlayerNumber playerNumber) override;
 
+		/**
+		 * \brief Binary heaps ordered by DelayPacketCompare, only due packets are popped each update
+		 */
 		std::vector<DelayPacket> receivedPackets_;
 		std::vector<DelayPacket> sentPackets_;
+		double currentTime_ = 0.0;
+		std::uint64_t packetSequence_ = 0;
 		std::array<std::unique_ptr<SimulationClient>, maxPlayerNmb>& clients_;
 
 
 		float avgDelay_ = 0.25f;
 		float marginDelay_ = 0.1f;
+		/**
+		 * \brief Owned by each server so several simulations can run on different threads
+		 */
+		std::mt19937 delayGenerator_{ std::random_device{}() };
 	};
 }
@@ -0,0 +1,73 @@
+#pragma once
+#include <array>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "pong_simulation_client.h"
+#include "pong_simulation_server.h"
+#include "engine/clock.h"
+#include "game/game_pong_globals.h"
+
+namespace game
+{
+    struct SoakSettings
+    {
+        float avgDelay = 0.1f;
+        float marginDelay = 0.05f;
+        /**
+         * \brief Matches still running after this frame are stopped and reported as unfinished
+         */
+        Frame maxFrames = 5 * 60 * 50;
+    };
+
+    struct SoakMatchResult
+    {
+        bool finished = false;
+        Frame frameCount = 0;
+        std::uint32_t desyncCount = 0;
+        std::uint64_t rollbackDepthSum = 0;
+        std::uint64_t rollbackSamples = 0;
+        Frame maxRollbackDepth = 0;
+        /**
+         * \brief CPU time in microseconds of each simulated frame (server and both clients)
+         */
+        std::vector<float> frameTimes;
+    };
+
+    /**
+     * \brief Headless match between a SimulationServer and two bot-controlled SimulationClient, without any rendering
+     */
+    class SoakMatch
+    {
+    public:
+        SoakMatch(std::uint32_t seed, const SoakSettings& settings);
+        SoakMatch(const SoakMatch&) = delete;
+        SoakMatch& operator=(const SoakMatch&) = delete;
+
+        void Init();
+        /**
+         * \brief Simulates one fixed period of the match, returns false when the match is over
+         */
+        bool Update();
+        [[nodiscard]] bool HasStarted() const;
+        [[nodiscard]] bool IsOver() const;
+        [[nodiscard]] const SoakMatchResult& GetResult() const { return result_; }
+    private:
+        struct BotState
+        {
+            PlayerInput input = PlayerInputEnum::NONE;
+            int remainingFrames = 0;
+        };
+        PlayerInput UpdateBotInput(BotState& botState);
+
+        //Shared by the server and the clients, advanced by one fixed period per update
+        core::ManualClock clock_;
+        std::array<std::unique_ptr<SimulationClient>, maxPlayerNmb> clients_;
+        SimulationServer server_;
+        SoakSettings settings_;
+        std::mt19937 botGenerator_;
+        std::array<BotState, maxPlayerNmb> botStates_{};
+        SoakMatchResult result_;
+    };
+}
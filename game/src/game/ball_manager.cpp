@@ -3,14 +3,25 @@
 #include "game/game_pong_manager.h"
 namespace game
 {
-    BallManager::BallManager(core::EntityManager& entityManager, GameManager& gameManager,
+    BallManager::BallManager(core::EntityManager& entityManager, core::WorldArena& arena, GameManager& gameManager,
         PhysicsManager& physicsManager,
-        PlayerCharacterManager& playerCharacterManager) :
-        ComponentManager(entityManager), gameManager_(gameManager), physicsManager_(physicsManager),
-        playerCharacterManager_(playerCharacterManager)
+        PlayerCharacterManager& playerCharacterManager,
+        core::Rng& rng) :
+        ComponentManager(entityManager, arena), gameManager_(gameManager), physicsManager_(physicsManager),
+        playerCharacterManager_(playerCharacterManager), rng_(rng)
     {
     }
 
+    void BallManager::Serve(Body& ball)
+    {
+        ball.position = core::Vec2f{ 0,0 };
+        //The generator is part of the rolled back state, every peer draws the same angle
+        const core::degree_t angle{ rng_.Range(-maxServeAngle, maxServeAngle) };
+        const auto speed = ball.velocity.GetMagnitude();
+        const auto direction = ball.velocity.x < 0.0f ? -1.0f : 1.0f;
+        ball.velocity = core::Vec2f{ direction * core::Cos(angle), core::Sin(angle) } * speed;
+    }
+
 
     void BallManager::FixedUpdate(sf::Time dt)
     {
@@ -25,7 +36,7 @@ namespace game
                 if (ball.position.x > rectShapeDim.x / 100)
                 {
                     auto firstPlayerEntity = gameManager_.GetEntityFromPlayerNumber(0);
-                    ball.position = core::Vec2f{0,0};
+                    Serve(ball);
                     auto player = playerCharacterManager_.GetComponent(firstPlayerEntity);
                     player.health--;
                     playerCharacterManager_.SetComponent(firstPlayerEntity,player);
@@ -33,7 +44,7 @@ namespace game
                 if (ball.position.x < -rectShapeDim.x / 100)
                 {
                    
-                    ball.position = core::Vec2f{ 0,0 };
+                    Serve(ball);
                    
                     auto secondPlayerEntity = gameManager_.GetEntityFromPlayerNumber(1);
                     auto player = playerCharacterManager_.GetComponent(secondPlayerEntity);
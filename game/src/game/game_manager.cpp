@@ -1,17 +1,23 @@
 #include <game/game_pong_manager.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include "utils/log.h"
 #include <fmt/format.h>
 #include <imgui.h>
 
+#include "game/pong_replay.h"
 #include "utils/conversion.h"
+#include "utils/profiler.h"
 
 namespace game
 {
 
-    GameManager::GameManager() :
+    GameManager::GameManager(const WorldCapacity& capacity) :
+        entityManager_(capacity.entityCount),
         transformManager_(entityManager_),
-        rollbackManager_(*this,entityManager_)
+        rollbackManager_(*this, entityManager_, capacity)
        
     {
         playerEntityMap_.fill(core::EntityManager::INVALID_ENTITY);
@@ -25,12 +31,20 @@ namespace game
         }
         core::LogDebug("[GameManager] Spawning new player");
         const auto entity = entityManager_.CreateEntity();
+        if (entity == core::EntityManager::INVALID_ENTITY)
+        {
+            return;
+        }
         playerEntityMap_[playerNumber] = entity;
         transformManager_.AddComponent(entity);
         transformManager_.SetPosition(entity, position);
         transformManager_.SetRotation(entity, rotation);
         transformManager_.SetScale(entity, core::Vec2f{5,5});
         rollbackManager_.SpawnPlayer(playerNumber, entity, position, core::degree_t(rotation));
+        if (replayRecorder_ != nullptr)
+        {
+            replayRecorder_->RecordPlayerSpawn(playerNumber, position, rotation);
+        }
     }
 
     core::Entity GameManager::GetEntityFromPlayerNumber(PlayerNumber playerNumber) const
@@ -57,7 +71,42 @@ namespace game
         {
             rollbackManager_.StartNewFrame(newValidateFrame);
         }
+        const auto lastValidateFrame = rollbackManager_.GetLastValidateFrame();
         rollbackManager_.ValidateFrame(newValidateFrame);
+        if (replayRecorder_ != nullptr)
+        {
+            //Validated inputs are final and still in the rollback input window
+            for (Frame frame = lastValidateFrame + 1; frame <= newValidateFrame; frame++)
+            {
+                std::array<PlayerInput, maxPlayerNmb> inputs{};
+                for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+                {
+                    inputs[playerNumber] = rollbackManager_.GetInputAtFrame(playerNumber, frame);
+                }
+                replayRecorder_->RecordInputs(frame, inputs);
+            }
+            replayRecorder_->RecordValidateState(rollbackManager_);
+        }
+    }
+
+    void GameManager::GetMemoryReport(core::MemoryReport& report) const
+    {
+        report.Add("Game", "Entities", entityManager_.GetMemoryUsage());
+        report.Add("Game", "Transforms", transformManager_.GetMemoryUsage());
+        rollbackManager_.GetMemoryReport(report);
+        if (replayRecorder_ != nullptr)
+        {
+            report.Add("Replay", "Recorder", replayRecorder_->GetMemoryUsage());
+        }
+    }
+
+    void GameManager::SetRandomSeed(std::uint32_t seed)
+    {
+        rollbackManager_.SetRandomSeed(seed);
+        if (replayRecorder_ != nullptr)
+        {
+            replayRecorder_->RecordRandomSeed(seed);
+        }
     }
 
     core::Entity GameManager::SpawnBall(PlayerNumber playerNumber, core::Vec2f position, core::Vec2f velocity)
@@ -66,6 +115,10 @@ namespace game
         Body ballbody;
         Box ballbox;
         const core::Entity entity = entityManager_.CreateEntity();
+        if (entity == core::EntityManager::INVALID_ENTITY)
+        {
+            return entity;
+        }
         ballbody.velocity = core::Vec2f{ 1,1 };
       
         
@@ -74,6 +127,10 @@ namespace game
         transformManager_.SetScale(entity, ballNewScale * ballScale);
         transformManager_.SetRotation(entity, core::degree_t(0.0f));
         rollbackManager_.SpawnBalle(playerNumber, entity, position, velocity);
+        if (replayRecorder_ != nullptr)
+        {
+            replayRecorder_->RecordBallSpawn(position, velocity);
+        }
         return entity;
     }
 
@@ -105,8 +162,8 @@ namespace game
         winner_ = winner;
     }
 
-    ClientGameManager::ClientGameManager(PacketSenderInterface& packetSenderInterface) :
-        GameManager(),
+    ClientGameManager::ClientGameManager(PacketSenderInterface& packetSenderInterface, const WorldCapacity& capacity) :
+        GameManager(capacity),
         spriteManager_(entityManager_, transformManager_),
         packetSenderInterface_(packetSenderInterface)
     {
@@ -114,18 +171,12 @@ namespace game
 
     void ClientGameManager::Init()
     {
-        //load textures
-        if (!ballTexture_.loadFromFile("data/sprites/bullet.png"))
-        {
-            core::LogError("Could not load bullet sprite");
-        }
-        if (!paletteTexture_.loadFromFile("data/sprites/Palette.jpg"))
-        {
-            core::LogError("Could not load ship sprite");
-        }
-        if (!pongBg_.loadFromFile("data/sprites/Pongbg.png"))
+        //The client is the one resimulating whole rollback windows within a frame
+        rollbackManager_.GetTickBudget().SetLogOverruns(true);
+        //load textures, all the sprites share one atlas texture so they are drawn in one batch
+        if (!spriteAtlas_.AddDirectory("data/sprites") || !spriteAtlas_.Build())
         {
-            core::LogError("Could not load pong background");
+            core::LogError("Could not load sprite atlas");
         }
         //load fonts
         if (!font_.loadFromFile("data/fonts/8-bit-hud.ttf"))
@@ -133,7 +184,6 @@ namespace game
             core::LogError("Could not load font");
         }
 
-        textRenderer_.setFont(font_);
         Body bgbody;
         Box bgbox;
         const auto bgEntity = entityManager_.CreateEntity();
@@ -147,18 +197,19 @@ namespace game
         rollTransformManager.SetRotation(bgEntity, transformManager_.GetRotation(bgEntity));
         rollTransformManager.SetScale(bgEntity, transformManager_.GetScale(bgEntity));
         spriteManager_.AddComponent(bgEntity);
-        spriteManager_.SetTexture(bgEntity, pongBg_);
-        spriteManager_.SetOrigin(bgEntity, sf::Vector2f(pongBg_.getSize()) / 2.0f);
+        const auto bgRect = spriteAtlas_.GetRect("Pongbg.png");
+        spriteManager_.SetTexture(bgEntity, spriteAtlas_.GetTexture(), bgRect);
+        spriteManager_.SetOrigin(bgEntity, sf::Vector2f(bgRect.width, bgRect.height) / 2.0f);
         
         pongBackground_.Init();
     }
 
     void ClientGameManager::Update(sf::Time dt)
     {
+        CORE_PROFILE_ZONE("ClientGameManager::Update");
         if (state_ & STARTED)
         {
             rollbackManager_.SimulateToCurrentFrame();
-            //Copy rollback transform position to our own
             for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
             {
                 if (entityManager_.HasComponent(entity,
@@ -179,14 +230,40 @@ namespace game
                         spriteManager_.SetColor(entity, playerColors[player.playerNumber]);
                     }
                 }
-
+            }
+            //Copy only the rollback transforms that changed to our own, positions are interpolated when drawing
+            auto& rollbackTransformManager = rollbackManager_.GetTransformManager();
+            const auto entitiesSize = rollbackTransformManager.GetAllPositions().size();
+            if (currentPositions_.size() < entitiesSize)
+            {
+                previousPositions_.resize(entitiesSize);
+                currentPositions_.resize(entitiesSize);
+                visualOffsets_.resize(entitiesSize);
+            }
+            UpdateVisualOffsets(dt);
+            if (interpolatedFrame_ != currentFrame_)
+            {
+                //A new frame was simulated, the last simulated frame becomes the start of the interpolation
+                previousPositions_ = currentPositions_;
+                interpolatedFrame_ = currentFrame_;
+            }
+            for (const auto entity : rollbackTransformManager.GetDirtyEntities())
+            {
                 if (entityManager_.HasComponent(entity, static_cast<core::EntityMask>(core::ComponentType::TRANSFORM)))
                 {
-                    transformManager_.SetPosition(entity, rollbackManager_.GetTransformManager().GetPosition(entity));
-                    transformManager_.SetScale(entity, rollbackManager_.GetTransformManager().GetScale(entity));
-                    transformManager_.SetRotation(entity, rollbackManager_.GetTransformManager().GetRotation(entity));
+                    const auto position = rollbackTransformManager.GetPosition(entity);
+                    if ((position - previousPositions_[entity]).GetSqrMagnitude() >
+                        interpolationSnapDistance * interpolationSnapDistance)
+                    {
+                        //Spawns and ball resets teleport
+                        previousPositions_[entity] = position;
+                    }
+                    currentPositions_[entity] = position;
+                    transformManager_.SetScale(entity, rollbackTransformManager.GetScale(entity));
+                    transformManager_.SetRotation(entity, rollbackTransformManager.GetRotation(entity));
                 }
             }
+            rollbackTransformManager.ClearDirtyEntities();
         }
         fixedTimer_ += dt.asSeconds();
         while (fixedTimer_ > FixedPeriod)
@@ -196,8 +273,79 @@ namespace game
 
         }
 
+        if (state_ & STARTED)
+        {
+            InterpolatePositions();
+        }
+
+    }
+
+    void ClientGameManager::UpdateVisualOffsets(sf::Time dt)
+    {
+        const auto decay = std::exp(-dt.asSeconds() / visualSmoothingTime);
+        for (auto& visualOffset : visualOffsets_)
+        {
+            visualOffset = visualOffset * decay;
+            if (visualOffset.GetSqrMagnitude() < visualOffsetEpsilon * visualOffsetEpsilon)
+            {
+                visualOffset = core::Vec2f::zero();
+            }
+        }
+        //Compare the frame we are showing with how it was just resimulated with the new inputs
+        const auto& rollbackManager = rollbackManager_;
+        if (rollbackManager.GetResimulatedFrame() != interpolatedFrame_)
+        {
+            return;
+        }
+        const auto& resimulatedBodies = rollbackManager.GetResimulatedBodies();
+        const auto size = std::min(resimulatedBodies.size(), currentPositions_.size());
+        for (core::Entity entity = 0; entity < size; entity++)
+        {
+            if (!entityManager_.HasComponent(entity,
+                static_cast<core::EntityMask>(core::ComponentType::BODY2D) |
+                static_cast<core::EntityMask>(core::ComponentType::TRANSFORM)))
+            {
+                continue;
+            }
+            const auto correctedPosition = resimulatedBodies[entity].position;
+            const auto error = currentPositions_[entity] - correctedPosition;
+            if (error.x == 0.0f && error.y == 0.0f)
+            {
+                continue;
+            }
+            //Big corrections (ex: a goal that was not predicted) are shown directly
+            if (visualSmoothingEnabled_ &&
+                error.GetSqrMagnitude() < visualSmoothingSnapDistance * visualSmoothingSnapDistance)
+            {
+                visualOffsets_[entity] += error;
+            }
+            currentPositions_[entity] = correctedPosition;
+        }
+    }
 
+    void ClientGameManager::InterpolatePositions()
+    {
+        //The remaining time of the fixed timer tells how far we are between the two last simulated frames
+        const float alpha = interpolationEnabled_ ? std::clamp(fixedTimer_ / FixedPeriod, 0.0f, 1.0f) : 1.0f;
+        for (core::Entity entity = 0; entity < currentPositions_.size(); entity++)
+        {
+            if (!entityManager_.HasComponent(entity, static_cast<core::EntityMask>(core::ComponentType::TRANSFORM)))
+            {
+                continue;
+            }
+            transformManager_.SetPosition(entity,
+                core::Vec2f::Lerp(previousPositions_[entity], currentPositions_[entity], alpha) + visualOffsets_[entity]);
+        }
+    }
 
+    void ClientGameManager::Tick()
+    {
+        //Rendering transforms are not copied, only the rollback simulation matters
+        if (state_ & STARTED)
+        {
+            rollbackManager_.SimulateToCurrentFrame();
+        }
+        FixedUpdate();
     }
 
     void ClientGameManager::Destroy()
@@ -214,69 +362,50 @@ namespace game
     }
 
     void ClientGameManager::Draw(sf::RenderTarget& target)
+    {
+        renderSnapshot_.Clear(originalView_);
+        WriteRenderSnapshot(renderSnapshot_);
+        renderSnapshot_.Draw(target, spriteBatch_);
+    }
+
+    void ClientGameManager::WriteRenderSnapshot(core::RenderSnapshot& snapshot)
     {
         UpdateCameraView();
-        target.setView(cameraView_);
+        snapshot.worldView = cameraView_;
+        if (pongBackground_.IsInitialized())
+        {
+            snapshot.backgrounds.push_back(&pongBackground_.GetDrawable());
+        }
+        spriteManager_.CopySprites(snapshot.sprites);
 
-        
-        
-        spriteManager_.Draw(target);
-        
-        target.setView(originalView_);
+        snapshot.hudView = originalView_;
+        const sf::Vector2f windowCenter{ windowSize_.x / 2.0f, windowSize_.y / 2.0f };
         if (state_ & FINISHED)
         {
             if (winner_ == GetPlayerNumber())
             {
-                const std::string winnerText = fmt::format("You won!");
-                textRenderer_.setFillColor(sf::Color::White);
-                textRenderer_.setString(winnerText);
-                textRenderer_.setCharacterSize(32);
-                const auto textBounds = textRenderer_.getLocalBounds();
-                textRenderer_.setPosition(windowSize_.x / 2.0f - textBounds.width/2.0f, 
-                    windowSize_.y / 2.0f - textBounds.height / 2.0f);
-                target.draw(textRenderer_);
+                snapshot.texts.push_back({ &font_, "You won!", windowCenter, 32, sf::Color::White, true });
             }
             else if (winner_ != INVALID_PLAYER)
             {
-                const std::string winnerText = fmt::format("P{} won!", winner_ + 1);
-                textRenderer_.setFillColor(sf::Color::White);
-                textRenderer_.setString(winnerText);
-                textRenderer_.setCharacterSize(32);
-                const auto textBounds = textRenderer_.getLocalBounds();
-                textRenderer_.setPosition(windowSize_.x / 2.0f - textBounds.width / 2.0f,
-                    windowSize_.y / 2.0f - textBounds.height / 2.0f);
-                target.draw(textRenderer_);
+                snapshot.texts.push_back({ &font_, fmt::format("P{} won!", winner_ + 1), windowCenter, 32,
+                    sf::Color::White, true });
             }
             else
             {
-                const std::string errorMessage = fmt::format("Error with other players");
-                textRenderer_.setFillColor(sf::Color::Red);
-                textRenderer_.setString(errorMessage);
-                textRenderer_.setCharacterSize(32);
-                const auto textBounds = textRenderer_.getLocalBounds();
-                textRenderer_.setPosition(windowSize_.x / 2.0f - textBounds.width / 2.0f,
-                    windowSize_.y / 2.0f - textBounds.height / 2.0f);
-                target.draw(textRenderer_);
+                snapshot.texts.push_back({ &font_, "Error with other players", windowCenter, 32,
+                    sf::Color::Red, true });
             }
         }
         if (!(state_ & STARTED))
         {
             if (startingTime_ != 0)
             {
-                using namespace std::chrono;
-                unsigned long long ms = duration_cast<milliseconds>(
-                    system_clock::now().time_since_epoch()
-                    ).count();
+                const auto ms = clock_->GetTimeMs();
                 if (ms < startingTime_)
                 {
-                    const std::string countDownText = fmt::format("Starts in {}", ((startingTime_ - ms) / 1000 + 1));
-                    textRenderer_.setFillColor(sf::Color::White);
-                    textRenderer_.setString(countDownText);
-                    textRenderer_.setCharacterSize(32);
-                    const auto textBounds = textRenderer_.getLocalBounds();
-                    textRenderer_.setPosition(windowSize_.x / 2.0f - textBounds.width / 2.0f,
-                        windowSize_.y / 2.0f - textBounds.height / 2.0f);
-                    target.draw(textRenderer_);
+                    snapshot.texts.push_back({ &font_, fmt::format("Starts in {}", ((startingTime_ - ms) / 1000 + 1)),
+                        windowCenter, 32, sf::Color::White, true });
                 }
             }
         }
@@ -293,13 +422,8 @@ namespace game
                 }
                 health += fmt::format("P{} health: {} ", playerNumber + 1, playerManager.GetComponent(playerEntity).health);
             }
-            textRenderer_.setFillColor(sf::Color::White);
-            textRenderer_.setString(health);
-            textRenderer_.setPosition(10, 10);
-            textRenderer_.setCharacterSize(20);
-            target.draw(textRenderer_);
+            snapshot.texts.push_back({ &font_, std::move(health), sf::Vector2f(10, 10), 20, sf::Color::White, false });
         }
-        
     }
 
     void ClientGameManager::SetClientPlayer(PlayerNumber clientPlayer)
@@ -309,13 +433,19 @@ namespace game
 
     void ClientGameManager::SpawnPlayer(PlayerNumber playerNumber, core::Vec2f position, core::degree_t rotation)
     {
-        core::LogDebug(fmt::format("Spawn player on client: {}", playerNumber));
+        CORE_LOG_DEBUG("Spawn player on client: {}", playerNumber);
 
         GameManager::SpawnPlayer(playerNumber, position, rotation);
         const auto entity = GetEntityFromPlayerNumber(playerNumber);
+        //Headless clients do not build the atlas and have no sprites
+        if (entity == core::EntityManager::INVALID_ENTITY || !spriteAtlas_.IsBuilt())
+        {
+            return;
+        }
         spriteManager_.AddComponent(entity);
-        spriteManager_.SetTexture(entity, paletteTexture_);
-        spriteManager_.SetOrigin(entity, sf::Vector2f(paletteTexture_.getSize())/2.0f);
+        const auto paletteRect = spriteAtlas_.GetRect("Palette.jpg");
+        spriteManager_.SetTexture(entity, spriteAtlas_.GetTexture(), paletteRect);
+        spriteManager_.SetOrigin(entity, sf::Vector2f(paletteRect.width, paletteRect.height) / 2.0f);
         auto sprite = spriteManager_.GetComponent(entity);
         sprite.setColor(playerColors[playerNumber]);
         spriteManager_.Flip(entity);
@@ -330,10 +460,14 @@ namespace game
         
         core::LogDebug("spawnballonclient");
         const auto entity = GameManager::SpawnBall(playerNumber, position, velocity);
-        
+        if (entity == core::EntityManager::INVALID_ENTITY || !spriteAtlas_.IsBuilt())
+        {
+            return entity;
+        }
         spriteManager_.AddComponent(entity);
-        spriteManager_.SetTexture(entity, ballTexture_);
-        spriteManager_.SetOrigin(entity, sf::Vector2f(ballTexture_.getSize())/2.0f);
+        const auto ballRect = spriteAtlas_.GetRect("bullet.png");
+        spriteManager_.SetTexture(entity, spriteAtlas_.GetTexture(), ballRect);
+        spriteManager_.SetOrigin(entity, sf::Vector2f(ballRect.width, ballRect.height) / 2.0f);
 
         return entity;
     }
@@ -345,11 +479,7 @@ namespace game
         {
             if (startingTime_ != 0)
             {
-               
-                using namespace std::chrono;
-                const auto ms = duration_cast<duration<unsigned long long, std::milli>>(
-                    system_clock::now().time_since_epoch()
-                    ).count();
+                const auto ms = clock_->GetTimeMs();
                 if (ms > startingTime_)
                 {
                     state_ = state_ | STARTED;
@@ -375,7 +505,7 @@ namespace game
         if (playerNumber == INVALID_PLAYER)
         {
             //We still did not receive the spawn player packet, but receive the start game packet
-            core::LogWarning(fmt::format("Invalid Player Entity in {}:line {}", __FILE__, __LINE__));
+            CORE_LOG_WARNING("Invalid Player Entity in {}:line {}", __FILE__, __LINE__);
             return;
         }
         const auto& inputs = rollbackManager_.GetInputs(playerNumber);
@@ -411,22 +541,25 @@ namespace game
         
         Ball ball;
         SpawnBall(maxPlayerNmb, ball.position, ball.velocity);
-        core::LogDebug(fmt::format("Start game at starting time: {}", startingTime));
+        CORE_LOG_DEBUG("Start game at starting time: {}", startingTime);
         startingTime_ = startingTime;
     }
 
     void ClientGameManager::DrawImGui()
     {
         ImGui::Text(state_ & STARTED ? "Game has started" : "Game has not started");
+        ImGui::Checkbox("Render interpolation", &interpolationEnabled_);
+        ImGui::Checkbox("Visual rollback smoothing", &visualSmoothingEnabled_);
         if (startingTime_ != 0)
         {
             ImGui::Text("Starting Time: %llu", startingTime_);
-            using namespace std::chrono;
-            unsigned long long ms = duration_cast<milliseconds>(
-                system_clock::now().time_since_epoch()
-                ).count();
-            ImGui::Text("Current Time: %llu", ms);
+            ImGui::Text("Current Time: %llu", clock_->GetTimeMs());
         }
+        rollbackManager_.GetMetrics().DrawImGui();
+        rollbackManager_.GetTickBudget().DrawImGui();
+        memoryReport_.Clear();
+        GetMemoryReport(memoryReport_);
+        memoryReport_.DrawImGui();
     }
 
     void ClientGameManager::ConfirmValidateFrame(Frame newValidateFrame,
@@ -442,11 +575,11 @@ namespace game
             if (rollbackManager_.GetLastReceivedFrame(playerNumber) < newValidateFrame)
             {
                 
-                core::LogDebug(fmt::format("[Warning] Trying to validate frame {} while playerNumber {} is at input frame {}, client player {}",
+                CORE_LOG_DEBUG("[Warning] Trying to validate frame {} while playerNumber {} is at input frame {}, client player {}",
                     newValidateFrame,
                     playerNumber + 1,
                     rollbackManager_.GetLastReceivedFrame(playerNumber),
-                    GetPlayerNumber()+1));
+                    GetPlayerNumber()+1);
                 
                 return;
             }
@@ -454,6 +587,16 @@ namespace game
         rollbackManager_.ConfirmFrame(newValidateFrame, physicsStates);
     }
 
+    void ClientGameManager::GetMemoryReport(core::MemoryReport& report) const
+    {
+        GameManager::GetMemoryReport(report);
+        report.Add("Graphics", "Sprites", spriteManager_.GetMemoryUsage());
+        auto interpolationUsage = core::GetMemoryUsage(previousPositions_);
+        interpolationUsage += core::GetMemoryUsage(currentPositions_);
+        interpolationUsage += core::GetMemoryUsage(visualOffsets_);
+        report.Add("Graphics", "Interpolation", interpolationUsage);
+    }
+
     void ClientGameManager::WinGame(PlayerNumber winner)
     {
         GameManager::WinGame(winner);
@@ -1,24 +1,22 @@
 #include <game/physics_pong_manager.h>
 
+#include <utils/profiler.h>
+
 namespace game
 {
 
-    PhysicsManager::PhysicsManager(core::EntityManager& entityManager) :
-        bodyManager_(entityManager), boxManager_(entityManager), entityManager_(entityManager)
-    {
-
-    }
-
-    bool Box2Box(float r1x, float r1y, float r1w, float r1h, float r2x, float r2y, float r2w, float r2h)
+    PhysicsManager::PhysicsManager(core::EntityManager& entityManager, core::WorldArena& arena) :
+        bodyManager_(entityManager, arena), boxManager_(entityManager, arena), entityManager_(entityManager)
     {
-        return r1x + r1w >= r2x &&    // r1 right edge past r2 left
-            r1x <= r2x + r2w &&    // r1 left edge past r2 right
-            r1y + r1h >= r2y &&    // r1 top edge past r2 bottom
-            r1y <= r2y + r2h;
+        contacts_.reserve(contactInitNmb);
+        colliderEntities_.reserve(entityManager.GetEntitiesSize());
+        colliderBoxes_.reserve(entityManager.GetEntitiesSize());
+        overlaps_.reserve(entityManager.GetEntitiesSize());
     }
 
     void PhysicsManager::FixedUpdate(sf::Time dt)
     {
+        CORE_PROFILE_ZONE("Physics::FixedUpdate");
         for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
         {
             if (!entityManager_.HasComponent(entity, static_cast<core::EntityMask>(core::ComponentType::BODY2D)))
@@ -28,42 +26,46 @@ namespace game
             
             bodyManager_.SetComponent(entity, body);
         }
+
+        //Gather the boxes of the active colliders contiguously for the narrow phase
+        colliderEntities_.clear();
+        colliderBoxes_.clear();
         for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
         {
             if (!entityManager_.HasComponent(entity,
-                                                   static_cast<core::EntityMask>(core::ComponentType::BODY2D) |
-                                                   static_cast<core::EntityMask>(core::ComponentType::BOX_COLLIDER2D)) ||
+                                             static_cast<core::EntityMask>(core::ComponentType::BODY2D) |
+                                             static_cast<core::EntityMask>(core::ComponentType::BOX_COLLIDER2D)) ||
                 entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
                 continue;
-            for (core::Entity otherEntity = entity; otherEntity < entityManager_.GetEntitiesSize(); otherEntity++)
+            colliderEntities_.push_back(entity);
+            colliderBoxes_.push_back(core::Aabb::FromCenter(
+                bodyManager_.GetComponent(entity).position, boxManager_.GetComponent(entity).extends));
+        }
+
+        contacts_.clear();
+        overlaps_.resize(colliderBoxes_.size());
+        const std::span<const core::Aabb> boxes = colliderBoxes_;
+        for (std::size_t i = 0; i < colliderBoxes_.size(); i++)
+        {
+            const auto otherCount = colliderBoxes_.size() - i - 1;
+            if (core::Overlaps(colliderBoxes_[i], boxes.subspan(i + 1),
+                std::span(overlaps_).first(otherCount)) == 0)
+            {
+                continue;
+            }
+            for (std::size_t j = 0; j < otherCount; j++)
             {
-                if (entity == otherEntity)
-                    continue;
-                if (!entityManager_.HasComponent(otherEntity,
-                                                 static_cast<core::EntityMask>(core::ComponentType::BODY2D) | static_cast<core::EntityMask>(core::ComponentType::BOX_COLLIDER2D)) ||
-                    entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
-                    continue;
-                const Body& body1 = bodyManager_.GetComponent(entity);
-                const Box& box1 = boxManager_.GetComponent(entity);
-
-                const Body& body2 = bodyManager_.GetComponent(otherEntity);
-                const Box& box2 = boxManager_.GetComponent(otherEntity);
-
-                if (Box2Box(
-                    body1.position.x - box1.extends.x,
-                    body1.position.y - box1.extends.y,
-                    box1.extends.x * 2.0f,
-                    box1.extends.y * 2.0f,
-                    body2.position.x - box2.extends.x,
-                    body2.position.y - box2.extends.y,
-                    box2.extends.x * 2.0f,
-                    box2.extends.y * 2.0f))
+                if (overlaps_[j])
                 {
-                    onTriggerAction_.Execute(entity, otherEntity);
+                    contacts_.push_back({ colliderEntities_[i], colliderEntities_[i + 1 + j] });
                 }
-
             }
         }
+
+        for (const auto& contact : contacts_)
+        {
+            onTriggerAction_.Execute(contact.entity1, contact.entity2);
+        }
     }
 
     void PhysicsManager::SetBody(core::Entity entity, const Body& body)
@@ -99,7 +101,7 @@ namespace game
     void PhysicsManager::RegisterTriggerListener(OnTriggerInterface& collisionInterface)
     {
         onTriggerAction_.RegisterCallback(
-            [&collisionInterface](core::Entity entity1, core::Entity entity2) { collisionInterface.OnTrigger(entity1, entity2); });
+            core::Delegate<core::Entity, core::Entity>::Bind<&OnTriggerInterface::OnTrigger>(collisionInterface));
     }
 
     void PhysicsManager::CopyAllComponents(const PhysicsManager& physicsManager)
@@ -107,4 +109,27 @@ namespace game
         bodyManager_.CopyAllComponents(physicsManager.bodyManager_.GetAllComponents());
         boxManager_.CopyAllComponents(physicsManager.boxManager_.GetAllComponents());
     }
+
+    void PhysicsManager::GetMemoryReport(core::MemoryReport& report, std::string_view subsystem) const
+    {
+        report.Add(subsystem, "Bodies", bodyManager_.GetMemoryUsage());
+        report.Add(subsystem, "Boxes", boxManager_.GetMemoryUsage());
+        auto narrowPhaseUsage = core::GetMemoryUsage(contacts_);
+        narrowPhaseUsage += core::GetMemoryUsage(colliderEntities_);
+        narrowPhaseUsage += core::GetMemoryUsage(colliderBoxes_);
+        narrowPhaseUsage += core::GetMemoryUsage(overlaps_);
+        report.Add(subsystem, "Narrow phase buffers", narrowPhaseUsage);
+    }
+
+    bool PhysicsManager::CopyAllComponents(std::span<const Body> bodies, std::span<const Box> boxes)
+    {
+        //Checking both counts first so a failed copy leaves the bodies and the boxes consistent
+        if (bodies.size() != GetAllBodies().size() || boxes.size() != GetAllBoxes().size())
+        {
+            CORE_LOG_ERROR("[Physics] Copying {} bodies and {} boxes in a physics manager of {} bodies and {} boxes",
+                bodies.size(), boxes.size(), GetAllBodies().size(), GetAllBoxes().size());
+            return false;
+        }
+        return bodyManager_.CopyAllComponents(bodies) && boxManager_.CopyAllComponents(boxes);
+    }
 }
@@ -3,8 +3,8 @@
 
 namespace game
 {
-    PlayerCharacterManager::PlayerCharacterManager(core::EntityManager& entityManager, PhysicsManager& physicsManager, GameManager& gameManager) :
-        ComponentManager(entityManager),
+    PlayerCharacterManager::PlayerCharacterManager(core::EntityManager& entityManager, core::WorldArena& arena, PhysicsManager& physicsManager, GameManager& gameManager) :
+        ComponentManager(entityManager, arena),
         physicsManager_(physicsManager),
         gameManager_(gameManager)
 
@@ -0,0 +1,399 @@
+#include <game/pong_replay.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <fmt/format.h>
+
+#include "utils/log.h"
+
+namespace game
+{
+    namespace
+    {
+        /**
+         * \brief Keyframe blob header, followed by the component arrays in the same order
+         */
+        struct ReplayKeyframeHeader
+        {
+            Frame frame = 0;
+            std::uint32_t bodyCount = 0;
+            std::uint32_t boxCount = 0;
+            std::uint32_t playerCharacterCount = 0;
+            std::uint32_t ballCount = 0;
+            std::uint32_t reserved = 0;
+            std::uint64_t rngState = 0;
+            std::uint64_t rngIncrement = 0;
+        };
+
+        std::size_t GetInputBitIndex(PlayerNumber playerNumber, Frame frame)
+        {
+            return (static_cast<std::size_t>(frame - 1) * maxPlayerNmb + playerNumber) * replayInputBits;
+        }
+
+        template<typename T>
+        void AppendArray(std::vector<std::uint8_t>& buffer, const std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const auto* valuesPtr = reinterpret_cast<const std::uint8_t*>(values.data());
+            buffer.insert(buffer.end(), valuesPtr, valuesPtr + values.size() * sizeof(T));
+        }
+
+        template<typename T>
+        bool ReadArray(const std::uint8_t*& data, const std::uint8_t* end, std::uint32_t count, std::vector<T>& values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const auto size = static_cast<std::size_t>(count) * sizeof(T);
+            if (static_cast<std::size_t>(end - data) < size)
+            {
+                return false;
+            }
+            values.resize(count);
+            std::memcpy(values.data(), data, size);
+            data += size;
+            return true;
+        }
+    }
+
+    std::size_t GetReplayInputsSize(Frame frameCount)
+    {
+        return (static_cast<std::size_t>(frameCount) * maxPlayerNmb * replayInputBits + 7) / 8;
+    }
+
+    PlayerInput UnpackReplayInput(const std::uint8_t* packedInputs, PlayerNumber playerNumber, Frame frame)
+    {
+        const auto bitIndex = GetInputBitIndex(playerNumber, frame);
+        return static_cast<PlayerInput>((packedInputs[bitIndex / 8] >> (bitIndex % 8)) & replayInputMask);
+    }
+
+    ReplayRecorder::ReplayRecorder()
+    {
+        Clear();
+    }
+
+    void ReplayRecorder::RecordPlayerSpawn(PlayerNumber playerNumber, core::Vec2f position, core::degree_t rotation)
+    {
+        auto& player = header_.players[playerNumber];
+        player.position = position;
+        player.rotation = rotation.value();
+    }
+
+    void ReplayRecorder::RecordBallSpawn(core::Vec2f position, core::Vec2f velocity)
+    {
+        header_.ballPosition = position;
+        header_.ballVelocity = velocity;
+    }
+
+    void ReplayRecorder::RecordRandomSeed(std::uint32_t seed)
+    {
+        header_.seed = seed;
+    }
+
+    void ReplayRecorder::RecordInputs(Frame frame, const std::array<PlayerInput, maxPlayerNmb>& inputs)
+    {
+        if (frame != header_.frameCount + 1)
+        {
+            CORE_LOG_ERROR("[Replay] Recording frame {} after frame {}", frame, header_.frameCount);
+            return;
+        }
+        header_.frameCount = frame;
+        const core::MemoryTagScope memoryTagScope(core::MemoryTag::Replay);
+        packedInputs_.resize(GetReplayInputsSize(frame), 0u);
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            const auto bitIndex = GetInputBitIndex(playerNumber, frame);
+            packedInputs_[bitIndex / 8] |= static_cast<std::uint8_t>(
+                (inputs[playerNumber] & replayInputMask) << (bitIndex % 8));
+        }
+    }
+
+    void ReplayRecorder::RecordValidateState(const RollbackManager& rollbackManager)
+    {
+        const Frame lastKeyframe = keyframeIndex_.empty() ? 0 : keyframeIndex_.back().frame;
+        if (rollbackManager.GetLastValidateFrame() < lastKeyframe + replayKeyframeInterval)
+        {
+            return;
+        }
+        const core::MemoryTagScope memoryTagScope(core::MemoryTag::Replay);
+        rollbackManager.GetValidateState(keyframeState_);
+
+        ReplayKeyframeHeader keyframeHeader;
+        keyframeHeader.frame = keyframeState_.frame;
+        keyframeHeader.bodyCount = static_cast<std::uint32_t>(keyframeState_.bodies.size());
+        keyframeHeader.boxCount = static_cast<std::uint32_t>(keyframeState_.boxes.size());
+        keyframeHeader.playerCharacterCount = static_cast<std::uint32_t>(keyframeState_.playerCharacters.size());
+        keyframeHeader.ballCount = static_cast<std::uint32_t>(keyframeState_.balls.size());
+        keyframeHeader.rngState = keyframeState_.rng.GetState();
+        keyframeHeader.rngIncrement = keyframeState_.rng.GetIncrement();
+
+        ReplayKeyframeEntry keyframe;
+        keyframe.frame = keyframeState_.frame;
+        keyframe.offset = keyframes_.size();
+        const auto* headerPtr = reinterpret_cast<const std::uint8_t*>(&keyframeHeader);
+        keyframes_.insert(keyframes_.end(), headerPtr, headerPtr + sizeof(keyframeHeader));
+        AppendArray(keyframes_, keyframeState_.bodies);
+        AppendArray(keyframes_, keyframeState_.boxes);
+        AppendArray(keyframes_, keyframeState_.playerCharacters);
+        AppendArray(keyframes_, keyframeState_.balls);
+        keyframe.size = static_cast<std::uint32_t>(keyframes_.size() - keyframe.offset);
+        keyframeIndex_.push_back(keyframe);
+    }
+
+    bool ReplayRecorder::Save(const std::string& path, PlayerNumber winner,
+        const std::array<PhysicsState, maxPlayerNmb>& finalPhysicsStates)
+    {
+        header_.winner = winner;
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            header_.players[playerNumber].finalPhysicsState = finalPhysicsStates[playerNumber];
+        }
+        //Keyframes taken after the last recorded frame cannot be reached
+        auto index = keyframeIndex_;
+        index.erase(std::remove_if(index.begin(), index.end(),
+            [this](const ReplayKeyframeEntry& keyframe) { return keyframe.frame > header_.frameCount; }),
+            index.end());
+        const std::uint64_t keyframesOffset = sizeof(header_) + packedInputs_.size();
+        for (auto& keyframe : index)
+        {
+            keyframe.offset += keyframesOffset;
+        }
+        header_.keyframeCount = static_cast<std::uint32_t>(index.size());
+        header_.indexOffset = keyframesOffset + keyframes_.size();
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            CORE_LOG_ERROR("[Replay] Could not open {} for writing", path);
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+        file.write(reinterpret_cast<const char*>(packedInputs_.data()),
+            static_cast<std::streamsize>(packedInputs_.size()));
+        file.write(reinterpret_cast<const char*>(keyframes_.data()),
+            static_cast<std::streamsize>(keyframes_.size()));
+        file.write(reinterpret_cast<const char*>(index.data()),
+            static_cast<std::streamsize>(index.size() * sizeof(ReplayKeyframeEntry)));
+        if (!file)
+        {
+            CORE_LOG_ERROR("[Replay] Could not write {}", path);
+            return false;
+        }
+        CORE_LOG_DEBUG("[Replay] Saved {} frames and {} keyframes to {}",
+            header_.frameCount, header_.keyframeCount, path);
+        return true;
+    }
+
+    core::MemoryUsage ReplayRecorder::GetMemoryUsage() const
+    {
+        auto usage = core::GetMemoryUsage(packedInputs_);
+        usage += core::GetMemoryUsage(keyframes_);
+        usage += core::GetMemoryUsage(keyframeIndex_);
+        usage += core::GetMemoryUsage(keyframeState_.bodies);
+        usage += core::GetMemoryUsage(keyframeState_.boxes);
+        usage += core::GetMemoryUsage(keyframeState_.playerCharacters);
+        usage += core::GetMemoryUsage(keyframeState_.balls);
+        return usage;
+    }
+
+    void ReplayRecorder::Clear()
+    {
+        header_ = ReplayHeader{};
+        header_.magic = replayMagic;
+        header_.version = replayVersion;
+        header_.playerCount = maxPlayerNmb;
+        packedInputs_.clear();
+        keyframes_.clear();
+        keyframeIndex_.clear();
+    }
+
+    bool Replay::Load(const std::string& path)
+    {
+        keyframeIndex_.clear();
+        packedInputs_ = nullptr;
+        if (!file_.Open(path))
+        {
+            return false;
+        }
+        const auto* data = file_.GetData();
+        const auto size = file_.GetSize();
+        if (size < sizeof(header_))
+        {
+            CORE_LOG_ERROR("[Replay] {} is not a replay file", path);
+            return false;
+        }
+        std::memcpy(&header_, data, sizeof(header_));
+        if (header_.magic != replayMagic)
+        {
+            CORE_LOG_ERROR("[Replay] {} is not a replay file", path);
+            return false;
+        }
+        if (header_.version != replayVersion || header_.playerCount != maxPlayerNmb)
+        {
+            CORE_LOG_ERROR("[Replay] {} has version {} with {} players, expected version {} with {} players",
+                path, header_.version, header_.playerCount, replayVersion, maxPlayerNmb);
+            return false;
+        }
+        const auto indexSize = static_cast<std::uint64_t>(header_.keyframeCount) * sizeof(ReplayKeyframeEntry);
+        if (sizeof(header_) + GetReplayInputsSize(header_.frameCount) > size ||
+            header_.indexOffset > size || indexSize > size - header_.indexOffset)
+        {
+            CORE_LOG_ERROR("[Replay] {} is truncated", path);
+            return false;
+        }
+        packedInputs_ = data + sizeof(header_);
+
+        keyframeIndex_.resize(header_.keyframeCount);
+        std::memcpy(keyframeIndex_.data(), data + header_.indexOffset, indexSize);
+        for (const auto& keyframe : keyframeIndex_)
+        {
+            if (keyframe.offset > size || keyframe.size > size - keyframe.offset)
+            {
+                CORE_LOG_ERROR("[Replay] {} has a keyframe outside of the file", path);
+                keyframeIndex_.clear();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    PlayerInput Replay::GetInput(PlayerNumber playerNumber, Frame frame) const
+    {
+        return UnpackReplayInput(packedInputs_, playerNumber, frame);
+    }
+
+    const ReplayKeyframeEntry* Replay::FindKeyframe(Frame frame) const
+    {
+        const auto it = std::upper_bound(keyframeIndex_.begin(), keyframeIndex_.end(), frame,
+            [](Frame value, const ReplayKeyframeEntry& keyframe) { return value < keyframe.frame; });
+        if (it == keyframeIndex_.begin())
+        {
+            return nullptr;
+        }
+        return &*std::prev(it);
+    }
+
+    bool Replay::LoadKeyframe(const ReplayKeyframeEntry& keyframe, RollbackState& state) const
+    {
+        const auto* data = file_.GetData() + keyframe.offset;
+        const auto* end = data + keyframe.size;
+        ReplayKeyframeHeader keyframeHeader;
+        if (keyframe.size < sizeof(keyframeHeader))
+        {
+            CORE_LOG_ERROR("[Replay] Keyframe at frame {} is truncated", keyframe.frame);
+            return false;
+        }
+        std::memcpy(&keyframeHeader, data, sizeof(keyframeHeader));
+        data += sizeof(keyframeHeader);
+        state.frame = keyframeHeader.frame;
+        state.rng.SetState(keyframeHeader.rngState, keyframeHeader.rngIncrement);
+        if (!ReadArray(data, end, keyframeHeader.bodyCount, state.bodies) ||
+            !ReadArray(data, end, keyframeHeader.boxCount, state.boxes) ||
+            !ReadArray(data, end, keyframeHeader.playerCharacterCount, state.playerCharacters) ||
+            !ReadArray(data, end, keyframeHeader.ballCount, state.balls))
+        {
+            CORE_LOG_ERROR("[Replay] Keyframe at frame {} is truncated", keyframe.frame);
+            return false;
+        }
+        return true;
+    }
+
+    ReplayPlayer::ReplayPlayer(const Replay& replay) : replay_(replay)
+    {
+    }
+
+    void ReplayPlayer::Init()
+    {
+        //Same spawn order as the server so the entities match
+        const auto& header = replay_.GetHeader();
+        gameManager_.SetRandomSeed(header.seed);
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            const auto& player = header.players[playerNumber];
+            gameManager_.SpawnPlayer(playerNumber, player.position, core::degree_t(player.rotation));
+        }
+        gameManager_.SpawnBall(maxPlayerNmb, header.ballPosition, header.ballVelocity);
+        gameManager_.GetRollbackManager().GetValidateState(initialState_);
+    }
+
+    bool ReplayPlayer::Update()
+    {
+        if (IsOver())
+        {
+            return false;
+        }
+        ValidateUntil(std::min(replay_.GetHeader().frameCount, GetCurrentFrame() + validateChunkSize));
+        return !IsOver();
+    }
+
+    bool ReplayPlayer::IsOver() const
+    {
+        return GetCurrentFrame() >= replay_.GetHeader().frameCount;
+    }
+
+    bool ReplayPlayer::Seek(Frame frame, bool useKeyframes)
+    {
+        frame = std::min(frame, replay_.GetHeader().frameCount);
+        const RollbackState* startState = &initialState_;
+        if (useKeyframes)
+        {
+            const auto* keyframe = replay_.FindKeyframe(frame);
+            if (keyframe != nullptr && replay_.LoadKeyframe(*keyframe, keyframeState_))
+            {
+                startState = &keyframeState_;
+            }
+        }
+        //Simulating forward from the current frame is cheaper if it is past the starting state
+        const auto currentFrame = GetCurrentFrame();
+        if ((currentFrame > frame || currentFrame < startState->frame) &&
+            !gameManager_.RestoreValidateState(*startState))
+        {
+            return false;
+        }
+        ValidateUntil(frame);
+        UpdateWinner();
+        return true;
+    }
+
+    void ReplayPlayer::ValidateUntil(Frame frame)
+    {
+        while (GetCurrentFrame() < frame)
+        {
+            const Frame startFrame = GetCurrentFrame() + 1;
+            const Frame endFrame = std::min(frame, startFrame + validateChunkSize - 1);
+            for (Frame inputFrame = startFrame; inputFrame <= endFrame; inputFrame++)
+            {
+                for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+                {
+                    gameManager_.SetPlayerInput(playerNumber, replay_.GetInput(playerNumber, inputFrame), inputFrame);
+                }
+            }
+            gameManager_.Validate(endFrame);
+            UpdateWinner();
+        }
+    }
+
+    void ReplayPlayer::UpdateWinner()
+    {
+        winner_ = gameManager_.CheckWinner();
+        gameManager_.WinGame(winner_);
+    }
+
+    bool ReplayPlayer::IsMatchingRecord() const
+    {
+        const auto& header = replay_.GetHeader();
+        if (!IsOver() || winner_ != header.winner)
+        {
+            return false;
+        }
+        const auto& rollbackManager = gameManager_.GetRollbackManager();
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            if (rollbackManager.GetValidatePhysicsState(playerNumber) != header.players[playerNumber].finalPhysicsState)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
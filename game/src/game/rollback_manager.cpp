@@ -1,30 +1,110 @@
 #include <game/pong_rollback_manager.h>
 #include <game/game_pong_manager.h>
+#include <algorithm>
 #include <cassert>
 #include <utils/log.h>
+#include <utils/profiler.h>
 #include <fmt/format.h>
 
 namespace game
 {
 
-    RollbackManager::RollbackManager(GameManager& gameManager, core::EntityManager& entityManager) :
+    RollbackManager::RollbackManager(GameManager& gameManager, core::EntityManager& entityManager, const WorldCapacity& capacity) :
         gameManager_(gameManager), entityManager_(entityManager),
+        currentArena_(GetWorldArenaSize(entityManager.GetEntitiesSize())),
+        lastValidateArena_(GetWorldArenaSize(entityManager.GetEntitiesSize())),
+        currentRng_(currentArena_.Allocate<core::Rng>(1).front()),
+        lastValidateRng_(lastValidateArena_.Allocate<core::Rng>(1).front()),
         currentTransformManager_(entityManager),
-        currentPhysicsManager_(entityManager), currentPlayerManager_(entityManager, currentPhysicsManager_, gameManager_),
-        currentBallManager_(entityManager, gameManager,currentPhysicsManager_,currentPlayerManager_),
-        lastValidatePhysicsManager_(entityManager),
-        lastValidatePlayerManager_(entityManager, lastValidatePhysicsManager_, gameManager_), 
-        lastValidateBallManager_(entityManager, gameManager,lastValidatePhysicsManager_,lastValidatePlayerManager_)
+        currentPhysicsManager_(entityManager, currentArena_),
+        currentPlayerManager_(entityManager, currentArena_, currentPhysicsManager_, gameManager_),
+        currentBallManager_(entityManager, currentArena_, gameManager,currentPhysicsManager_,currentPlayerManager_, currentRng_),
+        lastValidatePhysicsManager_(entityManager, lastValidateArena_),
+        lastValidatePlayerManager_(entityManager, lastValidateArena_, lastValidatePhysicsManager_, gameManager_),
+        lastValidateBallManager_(entityManager, lastValidateArena_, gameManager,lastValidatePhysicsManager_,lastValidatePlayerManager_, lastValidateRng_),
+        lockCapacity_(capacity.lockDuringSimulation)
     {
         for (auto& input : inputs_)
         {
             std::fill(input.begin(), input.end(), 0u);
         }
-        currentPhysicsManager_.RegisterTriggerListener(*this);
+        for (auto& predictedFrames : predictedFrames_)
+        {
+            std::fill(predictedFrames.begin(), predictedFrames.end(), INVALID_FRAME);
+        }
+        playerBallContacts_.reserve(maxPlayerNmb);
+        createdEntities_.reserve(capacity.entityCount);
+        frameTickId_ = tickBudget_.AddSystem("Frame", sf::Time::Zero);
+        ballTickId_ = tickBudget_.AddSystem("BallManager", sf::Time::Zero);
+        playerTickId_ = tickBudget_.AddSystem("PlayerCharacterManager", sf::Time::Zero);
+        physicsTickId_ = tickBudget_.AddSystem("PhysicsManager", sf::Time::Zero);
+        contactsTickId_ = tickBudget_.AddSystem("ResolveContacts", sf::Time::Zero);
+        SetTickBudget(defaultBudgetRollbackDepth);
+    }
+
+    std::size_t RollbackManager::GetWorldArenaSize(std::size_t entityCount)
+    {
+        return core::WorldArena::GetAllocationSize<core::Rng>(1) +
+            core::WorldArena::GetAllocationSize<Body>(entityCount) +
+            core::WorldArena::GetAllocationSize<Box>(entityCount) +
+            core::WorldArena::GetAllocationSize<PlayerCharacter>(entityCount) +
+            core::WorldArena::GetAllocationSize<Ball>(entityCount);
+    }
+
+    void RollbackManager::SetTickBudget(Frame maxRollbackDepth)
+    {
+        const auto frameBudget = sf::seconds(GameManager::FixedPeriod) / static_cast<sf::Int64>(std::max(maxRollbackDepth, 1u));
+        const auto systemCount = static_cast<sf::Int64>(tickBudget_.GetStats().size() - 1);
+        tickBudget_.SetBudget(frameTickId_, frameBudget);
+        for (const auto systemId : { ballTickId_, playerTickId_, physicsTickId_, contactsTickId_ })
+        {
+            tickBudget_.SetBudget(systemId, frameBudget / systemCount);
+        }
+    }
+
+    void RollbackManager::GetMemoryReport(core::MemoryReport& report) const
+    {
+        report.Add("Rollback current", "Transforms", currentTransformManager_.GetMemoryUsage());
+        currentPhysicsManager_.GetMemoryReport(report, "Rollback current");
+        report.Add("Rollback current", "Players", currentPlayerManager_.GetMemoryUsage());
+        report.Add("Rollback current", "Balls", currentBallManager_.GetMemoryUsage());
+        lastValidatePhysicsManager_.GetMemoryReport(report, "Rollback validate");
+        report.Add("Rollback validate", "Players", lastValidatePlayerManager_.GetMemoryUsage());
+        report.Add("Rollback validate", "Balls", lastValidateBallManager_.GetMemoryUsage());
+        constexpr auto inputWindowSize = sizeof(inputs_) + sizeof(predictedInputs_) + sizeof(predictedFrames_);
+        report.Add("Rollback", "Input window", { inputWindowSize, inputWindowSize });
+        auto bufferUsage = core::GetMemoryUsage(createdEntities_);
+        bufferUsage += core::GetMemoryUsage(playerBallContacts_);
+        bufferUsage += core::GetMemoryUsage(resimulatedBodies_);
+        report.Add("Rollback", "Buffers", bufferUsage);
+    }
+
+    void RollbackManager::FixedUpdateSystems()
+    {
+        const core::TickBudgetScope frameScope(tickBudget_, frameTickId_);
+        const auto dt = sf::seconds(GameManager::FixedPeriod);
+        {
+            const core::TickBudgetScope scope(tickBudget_, ballTickId_);
+            currentBallManager_.FixedUpdate(dt);
+        }
+        {
+            const core::TickBudgetScope scope(tickBudget_, playerTickId_);
+            currentPlayerManager_.FixedUpdate(dt);
+        }
+        {
+            const core::TickBudgetScope scope(tickBudget_, physicsTickId_);
+            currentPhysicsManager_.FixedUpdate(dt);
+        }
+        const core::TickBudgetScope scope(tickBudget_, contactsTickId_);
+        ResolveContacts();
     }
 
     void RollbackManager::SimulateToCurrentFrame()
     {
+        CORE_PROFILE_ZONE("Rollback::SimulateToCurrentFrame");
+        const core::MemoryTagScope memoryTagScope(core::MemoryTag::Rollback);
+        const core::CapacityLockScope capacityLockScope(entityManager_, lockCapacity_);
+        const sf::Clock simulationClock;
         const auto currentFrame = gameManager_.GetCurrentFrame();
         const auto lastValidateFrame = gameManager_.GetLastValidateFrame();
         //Destroying all created Entities after the last validated frame
@@ -46,10 +126,16 @@ namespace game
         }
         
         //Revert the current game state to the last validated game state
-        currentBallManager_.CopyAllComponents(lastValidateBallManager_.GetAllComponents());
-        currentPhysicsManager_.CopyAllComponents(lastValidatePhysicsManager_);
-        currentPlayerManager_.CopyAllComponents(lastValidatePlayerManager_.GetAllComponents());
+        currentArena_.CopyFrom(lastValidateArena_);
 
+        //Keep the new result of the previously simulated frame to measure the corrections
+        resimulatedFrame_ = INVALID_FRAME;
+        if (lastSimulatedFrame_ == lastValidateFrame)
+        {
+            const auto bodies = currentPhysicsManager_.GetAllBodies();
+            resimulatedBodies_.assign(bodies.begin(), bodies.end());
+            resimulatedFrame_ = lastSimulatedFrame_;
+        }
         for (Frame frame = lastValidateFrame + 1; frame <= currentFrame; frame++)
         {
             testedFrame_ = frame;
@@ -60,18 +146,36 @@ namespace game
                 const auto playerEntity = gameManager_.GetEntityFromPlayerNumber(playerNumber);
                 if(playerEntity == core::EntityManager::INVALID_ENTITY)
                 {
-                    core::LogWarning(fmt::format("Invalid Entity in {}:line {}", __FILE__, __LINE__));
+                    CORE_LOG_WARNING("Invalid Entity in {}:line {}", __FILE__, __LINE__);
                     continue;
                 }
                 auto playerCharacter = currentPlayerManager_.GetComponent(playerEntity);
                 playerCharacter.input = playerInput;
                 currentPlayerManager_.SetComponent(playerEntity, playerCharacter);
+                if (frame > lastReceivedFrame_[playerNumber])
+                {
+                    //Keep the latest prediction, it is compared to the real input once received
+                    const auto predictionIndex = frame % windowBufferSize;
+                    if (predictedFrames_[playerNumber][predictionIndex] != frame)
+                    {
+                        predictedFrames_[playerNumber][predictionIndex] = frame;
+                        metrics_.RecordPredictedInput();
+                    }
+                    predictedInputs_[playerNumber][predictionIndex] = playerInput;
+                }
             }
             //Simulate one frame of the game
-            currentBallManager_.FixedUpdate(sf::seconds(GameManager::FixedPeriod));
-            currentPlayerManager_.FixedUpdate(sf::seconds(GameManager::FixedPeriod));
-            currentPhysicsManager_.FixedUpdate(sf::seconds(GameManager::FixedPeriod));
+            FixedUpdateSystems();
+            if (frame == lastSimulatedFrame_)
+            {
+                const auto bodies = currentPhysicsManager_.GetAllBodies();
+                resimulatedBodies_.assign(bodies.begin(), bodies.end());
+                resimulatedFrame_ = lastSimulatedFrame_;
+            }
         }
+        lastSimulatedFrame_ = currentFrame;
+        metrics_.RecordSimulation(currentFrame - lastValidateFrame, simulationClock.getElapsedTime());
+        tickBudget_.Update();
         //Copy the physics states to the transforms
         for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
         {
@@ -92,6 +196,12 @@ namespace game
             StartNewFrame(inputFrame);
         }
         inputs_[playerNumber][currentFrame_ - inputFrame] = playerInput;
+        auto& predictedFrame = predictedFrames_[playerNumber][inputFrame % windowBufferSize];
+        if (predictedFrame == inputFrame)
+        {
+            metrics_.RecordPredictionResult(predictedInputs_[playerNumber][inputFrame % windowBufferSize] != playerInput);
+            predictedFrame = INVALID_FRAME;
+        }
         if (lastReceivedFrame_[playerNumber] < inputFrame)
         {
             lastReceivedFrame_[playerNumber] = inputFrame;
@@ -129,6 +239,9 @@ namespace game
 
     void RollbackManager::ValidateFrame(Frame newValidateFrame)
     {
+        CORE_PROFILE_ZONE("Rollback::ValidateFrame");
+        const core::MemoryTagScope memoryTagScope(core::MemoryTag::Rollback);
+        const core::CapacityLockScope capacityLockScope(entityManager_, lockCapacity_);
         const auto lastValidateFrame = gameManager_.GetLastValidateFrame();
         //Destroying all created Entities after the last validated frame
         for (const auto& createdEntity : createdEntities_)
@@ -159,9 +272,7 @@ namespace game
             }
         }
         //We use the current game state as the temporary new validate game state
-        currentBallManager_.CopyAllComponents(lastValidateBallManager_.GetAllComponents());
-        currentPhysicsManager_.CopyAllComponents(lastValidatePhysicsManager_);
-        currentPlayerManager_.CopyAllComponents(lastValidatePlayerManager_.GetAllComponents());
+        currentArena_.CopyFrom(lastValidateArena_);
 
         //We simulate the frames until the new validated frame
         for (Frame frame = lastValidateFrame_ + 1; frame <= newValidateFrame; frame++)
@@ -177,9 +288,7 @@ namespace game
                 currentPlayerManager_.SetComponent(playerEntity, playerCharacter);
             }
             //We simulate one frame
-            currentBallManager_.FixedUpdate(sf::seconds(GameManager::FixedPeriod));
-            currentPlayerManager_.FixedUpdate(sf::seconds(GameManager::FixedPeriod));
-            currentPhysicsManager_.FixedUpdate(sf::seconds(GameManager::FixedPeriod));
+            FixedUpdateSystems();
         }
         //Definitely remove DESTROY entities
         for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
@@ -190,12 +299,10 @@ namespace game
             }
         }
         //Copy back the new validate game state to the last validated game state
-        lastValidateBallManager_.CopyAllComponents(currentBallManager_.GetAllComponents());
-        
-        lastValidatePlayerManager_.CopyAllComponents(currentPlayerManager_.GetAllComponents());
-        lastValidatePhysicsManager_.CopyAllComponents(currentPhysicsManager_);
+        lastValidateArena_.CopyFrom(currentArena_);
         lastValidateFrame_ = newValidateFrame;
         createdEntities_.clear();
+        tickBudget_.Update();
     }
     void RollbackManager::ConfirmFrame(Frame newValidateFrame, const std::array<PhysicsState, maxPlayerNmb>& serverPhysicsState)
     {
@@ -205,10 +312,87 @@ namespace game
             const PhysicsState lastPhysicsState = GetValidatePhysicsState(playerNumber);
             if (serverPhysicsState[playerNumber] != lastPhysicsState)
             {
-                assert(false && "Physics State are not equal");
+                desyncCount_++;
+                CORE_LOG_ERROR("[Rollback] Physics state of player {} does not match the server one at frame {}",
+                    playerNumber, newValidateFrame);
             }
         }
     }
+    void RollbackManager::GetValidateState(RollbackState& state) const
+    {
+        state.frame = lastValidateFrame_;
+        const auto bodies = lastValidatePhysicsManager_.GetAllBodies();
+        state.bodies.assign(bodies.begin(), bodies.end());
+        const auto boxes = lastValidatePhysicsManager_.GetAllBoxes();
+        state.boxes.assign(boxes.begin(), boxes.end());
+        const auto playerCharacters = lastValidatePlayerManager_.GetAllComponents();
+        state.playerCharacters.assign(playerCharacters.begin(), playerCharacters.end());
+        const auto balls = lastValidateBallManager_.GetAllComponents();
+        state.balls.assign(balls.begin(), balls.end());
+        state.rng = lastValidateRng_;
+    }
+
+    void RollbackManager::SetRandomSeed(std::uint64_t seed)
+    {
+        lastValidateRng_.Seed(seed);
+        currentRng_ = lastValidateRng_;
+    }
+
+    bool RollbackManager::RestoreValidateState(const RollbackState& state)
+    {
+        if (state.bodies.size() != lastValidatePhysicsManager_.GetAllBodies().size() ||
+            state.boxes.size() != lastValidatePhysicsManager_.GetAllBoxes().size() ||
+            state.playerCharacters.size() != lastValidatePlayerManager_.GetAllComponents().size() ||
+            state.balls.size() != lastValidateBallManager_.GetAllComponents().size())
+        {
+            CORE_LOG_ERROR("[Rollback] State of frame {} was saved with another world capacity", state.frame);
+            return false;
+        }
+        lastValidatePhysicsManager_.CopyAllComponents(state.bodies, state.boxes);
+        lastValidatePlayerManager_.CopyAllComponents(state.playerCharacters);
+        lastValidateBallManager_.CopyAllComponents(state.balls);
+        lastValidateRng_ = state.rng;
+        OnValidateStateRestored(state.frame);
+        return true;
+    }
+
+    bool RollbackManager::RestoreValidateWorldState(std::span<const std::byte> worldState, Frame frame)
+    {
+        if (!lastValidateArena_.SetBytes(worldState))
+        {
+            return false;
+        }
+        OnValidateStateRestored(frame);
+        return true;
+    }
+
+    void RollbackManager::OnValidateStateRestored(Frame frame)
+    {
+        currentArena_.CopyFrom(lastValidateArena_);
+        lastValidateFrame_ = frame;
+        currentFrame_ = frame;
+        testedFrame_ = frame;
+        lastReceivedFrame_.fill(frame);
+        lastSimulatedFrame_ = INVALID_FRAME;
+        for (auto& input : inputs_)
+        {
+            std::fill(input.begin(), input.end(), 0u);
+        }
+        for (auto& predictedFrames : predictedFrames_)
+        {
+            std::fill(predictedFrames.begin(), predictedFrames.end(), INVALID_FRAME);
+        }
+        createdEntities_.clear();
+        for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
+        {
+            if (!entityManager_.HasComponent(entity,
+                                             static_cast<core::EntityMask>(core::ComponentType::BODY2D) |
+                                             static_cast<core::EntityMask>(core::ComponentType::TRANSFORM)))
+                continue;
+            currentTransformManager_.SetPosition(entity, currentPhysicsManager_.GetBody(entity).position);
+        }
+    }
+
     PhysicsState RollbackManager::GetValidatePhysicsState(PlayerNumber playerNumber) const
     {
         PhysicsState state = 0;
@@ -286,55 +470,49 @@ namespace game
         currentTransformManager_.SetScale(entity, core::Vec2f{ 5,5 });
     }
 
-    PlayerInput RollbackManager::GetInputAtFrame(PlayerNumber playerNumber, Frame frame)
+    PlayerInput RollbackManager::GetInputAtFrame(PlayerNumber playerNumber, Frame frame) const
     {
         assert(currentFrame_ - frame < inputs_[playerNumber].size() &&
             "Trying to get input too far in the past");
         return inputs_[playerNumber][currentFrame_ - frame];
     }
 
-    void RollbackManager::OnTrigger(core::Entity entity1, core::Entity entity2)
+    void RollbackManager::ManageCollision(const PlayerCharacter& player, core::Entity ballEntity)
     {
-        std::function<void(const PlayerCharacter&, core::Entity, const Ball&, core::Entity)> ManageCollision =
-            [this](const auto& player, auto playerEntity, const auto& ball, auto ballEntity)
+        auto ballbody = currentPhysicsManager_.GetBody(ballEntity);
+        if (player.playerNumber %2 == 0)
         {
-            auto ballbody = currentPhysicsManager_.GetBody(ballEntity);
-            if (player.playerNumber %2 == 0)
-            {
-                ballbody.velocity = core::Vec2f{ -abs(ballbody.velocity.x),ballbody.velocity.y };
-            }
-            else
+            ballbody.velocity = core::Vec2f{ -abs(ballbody.velocity.x),ballbody.velocity.y };
+        }
+        else
+        {
+            ballbody.velocity = core::Vec2f{ abs(ballbody.velocity.x),ballbody.velocity.y };
+        }
+        currentPhysicsManager_.SetBody(ballEntity, ballbody);
+    }
+
+    void RollbackManager::ResolveContacts()
+    {
+        playerBallContacts_.clear();
+        const auto playerMask = static_cast<core::EntityMask>(ComponentType::PLAYER_CHARACTER);
+        const auto ballMask = static_cast<core::EntityMask>(ComponentType::BALL);
+        for (const auto& contact : currentPhysicsManager_.GetContacts())
+        {
+            if (entityManager_.HasComponent(contact.entity1, playerMask) &&
+                entityManager_.HasComponent(contact.entity2, ballMask))
             {
-                ballbody.velocity = core::Vec2f{ abs(ballbody.velocity.x),ballbody.velocity.y };
+                playerBallContacts_.push_back({ contact.entity1, contact.entity2 });
             }
-            currentPhysicsManager_.SetBody(ballEntity, ballbody);
-           
+            else if (entityManager_.HasComponent(contact.entity2, playerMask) &&
+                entityManager_.HasComponent(contact.entity1, ballMask))
             {
-                
-                
+                playerBallContacts_.push_back({ contact.entity2, contact.entity1 });
             }
-           
-            
-                
-        };
-
-        if (entityManager_.HasComponent(entity1, static_cast<core::EntityMask>(ComponentType::PLAYER_CHARACTER)) &&
-            entityManager_.HasComponent(entity2, static_cast<core::EntityMask>(ComponentType::BALL)))
-        {
-            const auto& player = currentPlayerManager_.GetComponent(entity1);
-            const auto& bullet = currentBallManager_.GetComponent(entity2);
-            ManageCollision(player, entity1, bullet, entity2);
-
         }
-        if (entityManager_.HasComponent(entity2, static_cast<core::EntityMask>(ComponentType::PLAYER_CHARACTER)) &&
-            entityManager_.HasComponent(entity1, static_cast<core::EntityMask>(ComponentType::BALL)))
+        for (const auto& contact : playerBallContacts_)
         {
-            const auto& player = currentPlayerManager_.GetComponent(entity2);
-            const auto& bullet = currentBallManager_.GetComponent(entity1);
-            ManageCollision(player, entity2, bullet, entity1);
+            ManageCollision(currentPlayerManager_.GetComponent(contact.playerEntity), contact.ballEntity);
         }
-        
-        
     }
 
     void RollbackManager::SpawnBalle(PlayerNumber playerNumber, core::Entity entity, core::Vec2f position, core::Vec2f velocity)
@@ -0,0 +1,108 @@
+#include <game/pong_rollback_metrics.h>
+
+#include <algorithm>
+
+#include <imgui.h>
+
+namespace game
+{
+    void RollbackMetrics::RecordSimulation(Frame depth, sf::Time duration)
+    {
+        simulationCount_++;
+        resimulatedFrameCount_ += depth;
+        lastDepth_ = depth;
+        maxDepth_ = std::max(maxDepth_, depth);
+        depthHistogram_[std::min<std::size_t>(depth, depthHistogramSize - 1)]++;
+
+        lastSimulationTime_ = duration;
+        maxSimulationTime_ = std::max(maxSimulationTime_, duration);
+        simulationTimeSum_ += duration;
+
+        secondFrameCount_ += depth;
+        const auto elapsed = secondClock_.getElapsedTime();
+        if (elapsed >= sf::seconds(1.0f))
+        {
+            resimulatedFramesPerSecond_ = static_cast<float>(secondFrameCount_) / elapsed.asSeconds();
+            secondFrameCount_ = 0;
+            secondClock_.restart();
+        }
+    }
+
+    void RollbackMetrics::RecordPredictionResult(bool mispredicted)
+    {
+        checkedPredictionCount_++;
+        if (mispredicted)
+        {
+            mispredictedInputCount_++;
+        }
+    }
+
+    void RollbackMetrics::Reset()
+    {
+        *this = RollbackMetrics();
+    }
+
+    float RollbackMetrics::GetAverageDepth() const
+    {
+        if (simulationCount_ == 0)
+        {
+            return 0.0f;
+        }
+        return static_cast<float>(resimulatedFrameCount_) / static_cast<float>(simulationCount_);
+    }
+
+    float RollbackMetrics::GetMispredictionRate() const
+    {
+        if (checkedPredictionCount_ == 0)
+        {
+            return 0.0f;
+        }
+        return static_cast<float>(mispredictedInputCount_) / static_cast<float>(checkedPredictionCount_);
+    }
+
+    sf::Time RollbackMetrics::GetAverageSimulationTime() const
+    {
+        if (simulationCount_ == 0)
+        {
+            return sf::Time::Zero;
+        }
+        return simulationTimeSum_ / static_cast<sf::Int64>(simulationCount_);
+    }
+
+    sf::Time RollbackMetrics::GetAverageFrameSimulationTime() const
+    {
+        if (resimulatedFrameCount_ == 0)
+        {
+            return sf::Time::Zero;
+        }
+        return simulationTimeSum_ / static_cast<sf::Int64>(resimulatedFrameCount_);
+    }
+
+    void RollbackMetrics::DrawImGui()
+    {
+        if (!ImGui::CollapsingHeader("Rollback metrics"))
+        {
+            return;
+        }
+        ImGui::Text("Rollback depth: last %u, average %.2f, max %u", lastDepth_, GetAverageDepth(), maxDepth_);
+        std::array<float, depthHistogramSize> histogram{};
+        std::transform(depthHistogram_.begin(), depthHistogram_.end(), histogram.begin(),
+            [](std::uint64_t count) { return static_cast<float>(count); });
+        ImGui::PlotHistogram("Depth histogram", histogram.data(), static_cast<int>(histogram.size()),
+            0, nullptr, 0.0f, 3.4e38f, ImVec2(0.0f, 60.0f));
+        ImGui::Text("Resimulated frames per second: %.1f", resimulatedFramesPerSecond_);
+        ImGui::Text("Mispredicted inputs: %llu / %llu (%.1f%%)",
+            static_cast<unsigned long long>(mispredictedInputCount_),
+            static_cast<unsigned long long>(checkedPredictionCount_),
+            GetMispredictionRate() * 100.0f);
+        ImGui::Text("Simulation time: last %.3f ms, average %.3f ms, max %.3f ms",
+            lastSimulationTime_.asSeconds() * 1000.0f,
+            GetAverageSimulationTime().asSeconds() * 1000.0f,
+            maxSimulationTime_.asSeconds() * 1000.0f);
+        ImGui::Text("Time per simulated frame: %.3f ms", GetAverageFrameSimulationTime().asSeconds() * 1000.0f);
+        if (ImGui::Button("Reset rollback metrics"))
+        {
+            Reset();
+        }
+    }
+}
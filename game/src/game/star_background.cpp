@@ -1,26 +1,41 @@
 #include <game/pong_background.h>
 #include <SFML/Graphics/RenderTarget.hpp>
-#include "maths/basic.h"
 #include <engine/globals.h>
 
 namespace game
 {
-    void PongBackground::Init()
+    void PongBackground::Init(std::uint64_t seed)
     {
-        vertexArray_ = sf::VertexArray(sf::Points, starCount);
+        core::Rng rng(seed);
+        std::vector<float> coordinates(starCount * 2);
+        rng.Fill(coordinates, -50.0f * core::pixelPerMeter, 50.0f * core::pixelPerMeter);
 
+        vertices_.clear();
+        vertices_.resize(starCount);
         for (std::size_t i = 0; i < starCount; i++)
         {
-            auto& vertex = vertexArray_[i];
+            auto& vertex = vertices_[i];
             vertex.color = sf::Color::White;
-            vertex.position = sf::Vector2f(
-                core::RandomRange(-50.0f, 50.0f) * core::pixelPerMeter,
-                core::RandomRange(-50.0f, 50.0f) * core::pixelPerMeter);
+            vertex.position = sf::Vector2f(coordinates[2 * i], coordinates[2 * i + 1]);
+        }
+        //The stars never move, they are uploaded once
+        if (sf::VertexBuffer::isAvailable() && vertexBuffer_.create(vertices_.getVertexCount()))
+        {
+            vertexBuffer_.update(&vertices_[0]);
         }
     }
 
     void PongBackground::Draw(sf::RenderTarget& window)
     {
-        window.draw(vertexArray_);
+        window.draw(GetDrawable());
+    }
+
+    const sf::Drawable& PongBackground::GetDrawable() const
+    {
+        if (vertexBuffer_.getVertexCount() == vertices_.getVertexCount() && IsInitialized())
+        {
+            return vertexBuffer_;
+        }
+        return vertices_;
     }
 }
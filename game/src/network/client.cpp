@@ -30,6 +30,7 @@ namespace game
         {
             const auto* startGamePacket = static_cast<const StartGamePacket*>(packet);
             const auto startingTime = core::ConvertFromBinary<unsigned long long>(startGamePacket->startTime);
+            gameManager_.SetRandomSeed(core::ConvertFromBinary<std::uint32_t>(startGamePacket->seed));
             gameManager_.StartGame(startingTime);
             break;
         }
@@ -101,6 +102,14 @@ namespace game
             gameManager_.WinGame(winGamePacket->winner);
             break;
         }
+        case PacketType::PING:
+        {
+            //Send the ping back as is, the server measures the round trip with its own clock
+            auto pingPacket = std::make_unique<PingPacket>(*static_cast<const PingPacket*>(packet));
+            pingPacket->playerNumber = gameManager_.GetPlayerNumber();
+            SendUnreliablePacket(std::move(pingPacket));
+            break;
+        }
         case PacketType::SPAWN_BALL: break;
         default:;
         }
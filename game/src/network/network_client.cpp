@@ -4,6 +4,7 @@
 #include "maths/basic.h"
 #include "utils/conversion.h"
 #include "utils/log.h"
+#include "utils/memory.h"
 
 namespace game
 {
@@ -128,7 +129,7 @@ namespace game
             tcpSocket_.setBlocking(false);
             if (status == sf::Socket::Done)
             {
-                core::LogDebug("[Client] Connect to server " + serverAddress_ + " with port: " + std::to_string(serverTcpPort_));
+                CORE_LOG_DEBUG("[Client] Connect to server {} with port: {}", serverAddress_, serverTcpPort_);
                 auto joinPacket = std::make_unique<JoinPacket>();
                 joinPacket->clientId = core::ConvertToBinary<ClientId>(clientId_);
                 using namespace std::chrono;
@@ -139,8 +140,8 @@ namespace game
             }
             else
             {
-                core::LogDebug("[Client] Error trying to connect to " + serverAddress_ + " with port: " +
-                    std::to_string(serverTcpPort_) + " with status: " + std::to_string(status));
+                CORE_LOG_DEBUG("[Client] Error trying to connect to {} with port: {} with status: {}",
+                    serverAddress_, serverTcpPort_, static_cast<int>(status));
             }
         }
         ImGui::Text("Server UDP port: %u", serverUdpPort_);
@@ -211,13 +212,17 @@ namespace game
 
     void ClientNetworkManager::ReceivePacket(sf::Packet& packet, PacketSource source)
     {
-        const auto receivePacket = GenerateReceivedPacket(packet);
+        const auto receivePacket = [&packet]()
+        {
+            const core::MemoryTagScope memoryTagScope(core::MemoryTag::Network);
+            return GenerateReceivedPacket(packet);
+        }();
         Client::ReceivePacket(receivePacket.get());
         switch (receivePacket->packetType)
         {
         case PacketType::JOIN_ACK:
         {
-            core::LogDebug("[Client] Receive " + std::string(source == PacketSource::UDP ? "UDP" : "TCP") + " Join ACK Packet");
+            CORE_LOG_DEBUG("[Client] Receive {} Join ACK Packet", source == PacketSource::UDP ? "UDP" : "TCP");
             auto* joinAckPacket = static_cast<JoinAckPacket*>(receivePacket.get());
 
             serverUdpPort_ = core::ConvertFromBinary<unsigned short>(joinAckPacket->udpPort);
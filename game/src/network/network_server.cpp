@@ -2,6 +2,8 @@
 #include <utils/log.h>
 #include <fmt/format.h>
 #include <utils/conversion.h>
+#include <utils/memory.h>
+#include <utils/profiler.h>
 #include <cassert>
 
 namespace game
@@ -9,11 +11,14 @@ namespace game
     void ServerNetworkManager::SendReliablePacket(
         std::unique_ptr<Packet> packet)
     {
-        core::LogDebug(fmt::format("[Server] Sending TCP packet: {}",
-            std::to_string(static_cast<int>(packet->packetType))));
+        CORE_LOG_DEBUG("[Server] Sending TCP packet: {}", static_cast<int>(packet->packetType));
         for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb;
             playerNumber++)
         {
+            if (!(status_ & (FIRST_PLAYER_CONNECT << playerNumber)))
+            {
+                continue;
+            }
             sf::Packet sendingPacket;
             GeneratePacket(sendingPacket, *packet);
 
@@ -24,15 +29,19 @@ namespace game
                 switch (status)
                 {
                 case sf::Socket::NotReady:
-                    core::LogDebug(fmt::format(
+                    CORE_LOG_DEBUG(
                         "[Server] Error trying to send packet to Player: {} socket is not ready",
-                        playerNumber));
+                        playerNumber);
                     break;
                 case sf::Socket::Disconnected:
 
                     break;
                 }
             }
+            if (status == sf::Socket::Done)
+            {
+                metrics_.RecordPacketOut(playerNumber, sendingPacket.getDataSize());
+            }
         }
     }
 
@@ -44,7 +53,7 @@ namespace game
         {
             if (clientInfoMap_[playerNumber].udpRemotePort == 0)
             {
-                core::LogDebug(fmt::format("[Warning] Trying to send UDP packet, but missing port!"));
+                CORE_LOG_DEBUG("[Warning] Trying to send UDP packet, but missing port!");
                 continue;
             }
 
@@ -55,6 +64,7 @@ namespace game
             switch (status)
             {
             case sf::Socket::Done:
+                metrics_.RecordPacketOut(playerNumber, sendingPacket.getDataSize());
                 //core::LogDebug("[Server] Sending UDP packet: " +
                     //std::to_string(static_cast<int>(packet->packetType)));
                 break;
@@ -97,7 +107,7 @@ namespace game
         {
             socket.setBlocking(false);
         }
-        core::LogDebug(fmt::format("[Server] Tcp Socket on port: {}", tcpPort_));
+        CORE_LOG_DEBUG("[Server] Tcp Socket on port: {}", tcpPort_);
 
         status = sf::Socket::Error;
         while (status != sf::Socket::Done)
@@ -109,14 +119,17 @@ namespace game
             }
         }
         udpSocket_.setBlocking(false);
-        core::LogDebug(fmt::format("[Server] Udp Socket on port: {}", udpPort_));
+        CORE_LOG_DEBUG("[Server] Udp Socket on port: {}", udpPort_);
 
         status_ = status_ | OPEN;
+        metrics_.SetInstance(std::to_string(tcpPort_));
 
     }
 
     void ServerNetworkManager::Update(sf::Time dt)
     {
+        CORE_PROFILE_ZONE("Server::Update");
+        const sf::Clock tickClock;
         if (lastSocketIndex_ < maxPlayerNmb)
         {
             const sf::Socket::Status status = tcpListener_.accept(
@@ -125,8 +138,8 @@ namespace game
             {
                 const auto remoteAddress = tcpSockets_[lastSocketIndex_].
                     getRemoteAddress();
-                core::LogDebug(fmt::format("[Server] New player connection with address: {} and port: {}",
-                    remoteAddress.toString(), tcpSockets_[lastSocketIndex_].getRemotePort()));
+                CORE_LOG_DEBUG("[Server] New player connection with address: {} and port: {}",
+                    remoteAddress.toString(), tcpSockets_[lastSocketIndex_].getRemotePort());
                 status_ = status_ | (FIRST_PLAYER_CONNECT << lastSocketIndex_);
                 lastSocketIndex_++;
             }
@@ -141,13 +154,14 @@ namespace game
             switch (status)
             {
             case sf::Socket::Done:
+                metrics_.RecordPacketIn(playerNumber, tcpPacket.getDataSize());
                 ReceivePacket(tcpPacket, PacketSocketSource::TCP);
                 break;
             case sf::Socket::Disconnected:
             {
-                core::LogDebug(fmt::format(
+                CORE_LOG_DEBUG(
                     "[Error] Player Number {} is disconnected when receiving",
-                    playerNumber + 1));
+                    playerNumber + 1);
                 status_ = status_ & ~(FIRST_PLAYER_CONNECT << playerNumber);
                 auto endGame = std::make_unique<WinGamePacket>();
                 SendReliablePacket(std::move(endGame));
@@ -163,13 +177,16 @@ namespace game
         const auto status = udpSocket_.receive(udpPacket, address, port);
         if (status == sf::Socket::Done)
         {
+            metrics_.RecordPacketIn(FindUdpPlayer(address, port), udpPacket.getDataSize());
             ReceivePacket(udpPacket, PacketSocketSource::UDP, address, port);
         }
+        UpdateMetrics(dt);
+        metrics_.RecordTick(tickClock.getElapsedTime());
     }
 
     void ServerNetworkManager::Destroy()
     {
-
+        DumpMetrics();
     }
 
     void ServerNetworkManager::SetTcpPort(unsigned short i)
@@ -182,6 +199,19 @@ namespace game
         return status_ & OPEN;
     }
 
+    PlayerNumber ServerNetworkManager::FindUdpPlayer(const sf::IpAddress& address, unsigned short port) const
+    {
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            const auto& clientInfo = clientInfoMap_[playerNumber];
+            if (clientInfo.udpRemotePort == port && clientInfo.udpRemoteAddress == address)
+            {
+                return playerNumber;
+            }
+        }
+        return INVALID_PLAYER;
+    }
+
     void ServerNetworkManager::SpawnNewPlayer(ClientId clientId, PlayerNumber playerNumber)
     {
         //Spawning the new player in the arena
@@ -218,8 +248,8 @@ namespace game
             const auto joinPacket = *static_cast<JoinPacket*>(packet.get());
             Server::ReceivePacket(std::move(packet));
             auto clientId = core::ConvertFromBinary<ClientId>(joinPacket.clientId);
-            core::LogDebug(fmt::format("[Server] Received Join Packet from: {} {}", clientId,
-                (packetSource == PacketSocketSource::UDP ? fmt::format(" UDP with port: {}", port) : " TCP")));
+            CORE_LOG_DEBUG("[Server] Received Join Packet from: {} {}", clientId,
+                (packetSource == PacketSocketSource::UDP ? fmt::format(" UDP with port: {}", port) : " TCP"));
             const auto it = std::find(clientMap_.begin(), clientMap_.end(), clientId);
             PlayerNumber playerNumber;
             if (it != clientMap_.end())
@@ -249,7 +279,7 @@ namespace game
                 const auto clientTime = core::ConvertFromBinary<unsigned long>(joinPacket.startTime);
                 using namespace std::chrono;
                 const unsigned long deltaTime = (duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count()) - clientTime;
-                core::LogDebug(fmt::format("[Server] Client Server deltaTime: {}", deltaTime));
+                CORE_LOG_DEBUG("[Server] Client Server deltaTime: {}", deltaTime);
                 clientInfoMap_[playerNumber].timeDifference = deltaTime;
             }
             break;
@@ -265,7 +295,11 @@ namespace game
         sf::IpAddress address,
         unsigned short port)
     {
-        auto receivedPacket = GenerateReceivedPacket(packet);
+        auto receivedPacket = [&packet]()
+        {
+            const core::MemoryTagScope memoryTagScope(core::MemoryTag::Network);
+            return GenerateReceivedPacket(packet);
+        }();
 
         if (receivedPacket != nullptr)
         {
@@ -2,10 +2,61 @@
 #include <utils/log.h>
 #include <fmt/format.h>
 #include <utils/conversion.h>
+#include <algorithm>
 #include <cstdint>
 
 namespace game
 {
+    void Server::SetReplayPath(std::string_view replayPath)
+    {
+        replayPath_ = replayPath;
+        replayRecorder_.Clear();
+        gameManager_.SetReplayRecorder(replayPath_.empty() ? nullptr : &replayRecorder_);
+    }
+
+
+    bool Server::DumpMetrics()
+    {
+        if (metricsPath_.empty())
+        {
+            return false;
+        }
+        memoryReport_.Clear();
+        gameManager_.GetMemoryReport(memoryReport_);
+        metrics_.SetMemoryReport(memoryReport_);
+        return metrics_.DumpPrometheus(metricsPath_);
+    }
+
+    void Server::UpdateMetrics(sf::Time dt)
+    {
+        pingTimer_ += dt;
+        if (pingTimer_ >= sf::seconds(pingPeriod) && lastPlayerNumber_ > 0)
+        {
+            pingTimer_ = sf::Time::Zero;
+            auto pingPacket = std::make_unique<PingPacket>();
+            pingPacket->serverTime = core::ConvertToBinary(clock_->GetTimeMs());
+            SendUnreliablePacket(std::move(pingPacket));
+        }
+
+        const auto& rollbackManager = gameManager_.GetRollbackManager();
+        Frame newestReceivedFrame = 0;
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            newestReceivedFrame = std::max(newestReceivedFrame, rollbackManager.GetLastReceivedFrame(playerNumber));
+        }
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            metrics_.SetValidateLag(playerNumber, newestReceivedFrame - rollbackManager.GetLastReceivedFrame(playerNumber));
+        }
+        metrics_.SetValidateFrame(gameManager_.GetLastValidateFrame());
+
+        metricsDumpTimer_ += dt;
+        if (metricsDumpTimer_ >= sf::seconds(metricsDumpPeriod))
+        {
+            metricsDumpTimer_ = sf::Time::Zero;
+            DumpMetrics();
+        }
+    }
 
     void Server::ReceivePacket(std::unique_ptr<Packet> packet)
     {
@@ -21,7 +72,7 @@ namespace game
                 //Player joined twice!
                 return;
             }
-            core::LogDebug("Managing Received Packet Join from: " + std::to_string(clientId));
+            CORE_LOG_DEBUG("Managing Received Packet Join from: {}", clientId);
             clientMap_[lastPlayerNumber_] = clientId;
             SpawnNewPlayer(clientId, lastPlayerNumber_);
 
@@ -32,12 +83,12 @@ namespace game
                 Ball ball;
                 auto startGamePacket = std::make_unique<StartGamePacket>();
                 startGamePacket->packetType = PacketType::START_GAME;
-                using namespace std::chrono;
-                const auto ms = (duration_cast<duration<unsigned long long, std::milli>>(
-                    system_clock::now().time_since_epoch()
-                    ) + milliseconds(3000)).count();
+                const auto ms = clock_->GetTimeMs() + 3000;
                 startGamePacket->startTime = core::ConvertToBinary(ms);
+                startGamePacket->seed = core::ConvertToBinary(gameSeed_);
                 SendReliablePacket(std::move(startGamePacket));
+                metrics_.RecordMatchStarted();
+                gameManager_.SetRandomSeed(gameSeed_);
                 gameManager_.SpawnBall(maxPlayerNmb,ball.position,ball.velocity);
             }
 
@@ -49,6 +100,12 @@ namespace game
             const auto* playerInputPacket = static_cast<const PlayerInputPacket*>(packet.get());
             const auto playerNumber = playerInputPacket->playerNumber;
             const auto inputFrame = core::ConvertFromBinary<Frame>(playerInputPacket->currentFrame);
+            metrics_.RecordInputPacket(playerNumber, inputFrame);
+            if (gameManager_.GetWinner() != INVALID_PLAYER)
+            {
+                //Inputs sent before the clients received the win are not validated anymore
+                break;
+            }
 
             for (std::uint32_t i = 0; i < playerInputPacket->inputs.size(); i++)
             {
@@ -95,16 +152,39 @@ namespace game
                 const auto winner = gameManager_.CheckWinner();
                 if (winner != INVALID_PLAYER)
                 {
+                    if (!replayPath_.empty())
+                    {
+                        std::array<PhysicsState, maxPlayerNmb> physicsStates{};
+                        for (PlayerNumber i = 0; i < maxPlayerNmb; i++)
+                        {
+                            physicsStates[i] = gameManager_.GetRollbackManager().GetValidatePhysicsState(i);
+                        }
+                        replayRecorder_.Save(replayPath_, winner, physicsStates);
+                        gameManager_.SetReplayRecorder(nullptr);
+                    }
                     //core::LogDebug(fmt::format("Server declares P{} a winner", winner + 1));
                     auto winGamePacket = std::make_unique<WinGamePacket>();
                     winGamePacket->winner = winner;
                     SendReliablePacket(std::move(winGamePacket));
                     gameManager_.WinGame(winner);
+                    metrics_.RecordMatchFinished();
+                    DumpMetrics();
                 }
             }
 
             break;
         }
+        case PacketType::PING:
+        {
+            const auto* pingPacket = static_cast<const PingPacket*>(packet.get());
+            const auto serverTime = core::ConvertFromBinary<unsigned long long>(pingPacket->serverTime);
+            const auto now = clock_->GetTimeMs();
+            if (now >= serverTime)
+            {
+                metrics_.RecordRoundTrip(pingPacket->playerNumber, sf::milliseconds(static_cast<sf::Int32>(now - serverTime)));
+            }
+            break;
+        }
         default: break;
         }
     }
@@ -0,0 +1,216 @@
+#include <network/pong_server_metrics.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "utils/log.h"
+
+namespace game
+{
+    void ServerMetrics::RecordPacketIn(PlayerNumber playerNumber, std::size_t bytes)
+    {
+        packetsIn_++;
+        bytesIn_ += bytes;
+        if (playerNumber < maxPlayerNmb)
+        {
+            clients_[playerNumber].packetsIn++;
+            clients_[playerNumber].bytesIn += bytes;
+        }
+    }
+
+    void ServerMetrics::RecordPacketOut(PlayerNumber playerNumber, std::size_t bytes)
+    {
+        packetsOut_++;
+        bytesOut_ += bytes;
+        if (playerNumber < maxPlayerNmb)
+        {
+            clients_[playerNumber].packetsOut++;
+            clients_[playerNumber].bytesOut += bytes;
+        }
+    }
+
+    void ServerMetrics::RecordInputPacket(PlayerNumber playerNumber, Frame inputFrame)
+    {
+        if (playerNumber >= maxPlayerNmb)
+        {
+            return;
+        }
+        //The clients send one input packet per frame, a gap in the frames is a lost or late packet
+        auto& client = clients_[playerNumber];
+        if (client.inputPacketsReceived == 0 || inputFrame > client.lastInputFrame)
+        {
+            if (client.inputPacketsReceived != 0)
+            {
+                client.inputPacketsLost += inputFrame - client.lastInputFrame - 1;
+            }
+            client.lastInputFrame = inputFrame;
+        }
+        else if (client.inputPacketsLost > 0)
+        {
+            client.inputPacketsLost--;
+        }
+        client.inputPacketsReceived++;
+    }
+
+    void ServerMetrics::RecordRoundTrip(PlayerNumber playerNumber, sf::Time roundTripTime)
+    {
+        if (playerNumber >= maxPlayerNmb)
+        {
+            return;
+        }
+        auto& client = clients_[playerNumber];
+        client.roundTripTime = client.pingCount == 0 ?
+            roundTripTime :
+            client.roundTripTime + (roundTripTime - client.roundTripTime) * roundTripSmoothing;
+        client.pingCount++;
+    }
+
+    void ServerMetrics::SetValidateLag(PlayerNumber playerNumber, Frame validateLag)
+    {
+        if (playerNumber < maxPlayerNmb)
+        {
+            clients_[playerNumber].validateLag = validateLag;
+        }
+    }
+
+    void ServerMetrics::RecordTick(sf::Time tickTime)
+    {
+        tickTimes_[tickCount_ % tickWindowSize] = tickTime;
+        tickCount_++;
+        tickTimeSum_ += tickTime;
+    }
+
+    sf::Time ServerMetrics::GetTickTimePercentile(float percentile) const
+    {
+        const auto count = static_cast<std::size_t>(std::min<std::uint64_t>(tickCount_, tickWindowSize));
+        if (count == 0)
+        {
+            return sf::Time::Zero;
+        }
+        std::vector<sf::Time> tickTimes(tickTimes_.begin(), tickTimes_.begin() + count);
+        const auto index = std::min(count - 1, static_cast<std::size_t>(percentile * static_cast<float>(count)));
+        std::nth_element(tickTimes.begin(), tickTimes.begin() + index, tickTimes.end());
+        return tickTimes[index];
+    }
+
+    std::string ServerMetrics::WritePrometheus() const
+    {
+        std::string out;
+        auto writer = std::back_inserter(out);
+        const auto instance = fmt::format("instance=\"{}\"", instance_);
+        const auto writeHeader = [&writer](std::string_view name, std::string_view type, std::string_view help)
+        {
+            fmt::format_to(writer, "# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+        };
+        const auto writeClients = [&](std::string_view name, std::string_view type, std::string_view help,
+            auto getValue)
+        {
+            writeHeader(name, type, help);
+            for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+            {
+                fmt::format_to(writer, "{}{{{},player=\"{}\"}} {}\n",
+                    name, instance, playerNumber + 1, getValue(clients_[playerNumber]));
+            }
+        };
+        writeClients("pong_client_packets_received_total", "counter", "Packets received from the client",
+            [](const ClientMetrics& client) { return client.packetsIn; });
+        writeClients("pong_client_bytes_received_total", "counter", "Bytes received from the client",
+            [](const ClientMetrics& client) { return client.bytesIn; });
+        writeClients("pong_client_packets_sent_total", "counter", "Packets sent to the client",
+            [](const ClientMetrics& client) { return client.packetsOut; });
+        writeClients("pong_client_bytes_sent_total", "counter", "Bytes sent to the client",
+            [](const ClientMetrics& client) { return client.bytesOut; });
+        writeClients("pong_client_input_packets_received_total", "counter", "Input packets received from the client",
+            [](const ClientMetrics& client) { return client.inputPacketsReceived; });
+        writeClients("pong_client_input_packets_lost_total", "counter", "Input packets missing from the frame sequence",
+            [](const ClientMetrics& client) { return client.inputPacketsLost; });
+        writeClients("pong_client_round_trip_seconds", "gauge", "Smoothed round trip time of the pings",
+            [](const ClientMetrics& client) { return client.roundTripTime.asSeconds(); });
+        writeClients("pong_client_validate_lag_frames", "gauge", "Frames the client inputs trail the newest input",
+            [](const ClientMetrics& client) { return client.validateLag; });
+
+        writeHeader("pong_server_packets_received_total", "counter", "Packets received by the server");
+        fmt::format_to(writer, "pong_server_packets_received_total{{{}}} {}\n", instance, packetsIn_);
+        writeHeader("pong_server_bytes_received_total", "counter", "Bytes received by the server");
+        fmt::format_to(writer, "pong_server_bytes_received_total{{{}}} {}\n", instance, bytesIn_);
+        writeHeader("pong_server_packets_sent_total", "counter", "Packets sent by the server");
+        fmt::format_to(writer, "pong_server_packets_sent_total{{{}}} {}\n", instance, packetsOut_);
+        writeHeader("pong_server_bytes_sent_total", "counter", "Bytes sent by the server");
+        fmt::format_to(writer, "pong_server_bytes_sent_total{{{}}} {}\n", instance, bytesOut_);
+        writeHeader("pong_server_matches_started_total", "counter", "Matches started");
+        fmt::format_to(writer, "pong_server_matches_started_total{{{}}} {}\n", instance, matchesStarted_);
+        writeHeader("pong_server_matches_finished_total", "counter", "Matches finished with a winner");
+        fmt::format_to(writer, "pong_server_matches_finished_total{{{}}} {}\n", instance, matchesFinished_);
+        writeHeader("pong_server_validate_frame", "gauge", "Last validated frame of the match");
+        fmt::format_to(writer, "pong_server_validate_frame{{{}}} {}\n", instance, validateFrame_);
+
+        writeHeader("pong_server_tick_seconds", "summary", "Duration of the server updates, quantiles over the last ticks");
+        for (const auto quantile : { 0.5f, 0.9f, 0.99f })
+        {
+            fmt::format_to(writer, "pong_server_tick_seconds{{{},quantile=\"{}\"}} {}\n",
+                instance, quantile, GetTickTimePercentile(quantile).asSeconds());
+        }
+        fmt::format_to(writer, "pong_server_tick_seconds_sum{{{}}} {}\n", instance, tickTimeSum_.asSeconds());
+        fmt::format_to(writer, "pong_server_tick_seconds_count{{{}}} {}\n", instance, tickCount_);
+
+        writeHeader("pong_match_memory_bytes", "gauge", "Memory of the match managers, reserved and used by live elements");
+        for (const auto& entry : memoryReport_.GetEntries())
+        {
+            fmt::format_to(writer, "pong_match_memory_bytes{{{},subsystem=\"{}\",name=\"{}\",kind=\"reserved\"}} {}\n",
+                instance, entry.subsystem, entry.name, entry.usage.capacityBytes);
+            fmt::format_to(writer, "pong_match_memory_bytes{{{},subsystem=\"{}\",name=\"{}\",kind=\"live\"}} {}\n",
+                instance, entry.subsystem, entry.name, entry.usage.liveBytes);
+        }
+        if (core::IsMemoryTrackingEnabled())
+        {
+            writeHeader("pong_process_heap_bytes", "gauge", "Heap bytes allocated per memory tag");
+            for (std::size_t tag = 0; tag < static_cast<std::size_t>(core::MemoryTag::Length); tag++)
+            {
+                const auto memoryTag = static_cast<core::MemoryTag>(tag);
+                fmt::format_to(writer, "pong_process_heap_bytes{{{},tag=\"{}\"}} {}\n",
+                    instance, core::GetMemoryTagName(memoryTag), core::GetMemoryTagStats(memoryTag).currentBytes);
+            }
+            writeHeader("pong_process_heap_peak_bytes", "gauge", "Peak heap bytes allocated per memory tag");
+            for (std::size_t tag = 0; tag < static_cast<std::size_t>(core::MemoryTag::Length); tag++)
+            {
+                const auto memoryTag = static_cast<core::MemoryTag>(tag);
+                fmt::format_to(writer, "pong_process_heap_peak_bytes{{{},tag=\"{}\"}} {}\n",
+                    instance, core::GetMemoryTagName(memoryTag), core::GetMemoryTagStats(memoryTag).peakBytes);
+            }
+        }
+        return out;
+    }
+
+    bool ServerMetrics::DumpPrometheus(const std::string& path) const
+    {
+        const auto tmpPath = path + ".tmp";
+        auto* file = std::fopen(tmpPath.c_str(), "w");
+        if (file == nullptr)
+        {
+            CORE_LOG_ERROR("[Server] Could not open {} for writing", tmpPath);
+            return false;
+        }
+        const auto metrics = WritePrometheus();
+        const auto written = std::fwrite(metrics.data(), 1, metrics.size(), file);
+        std::fclose(file);
+        if (written != metrics.size())
+        {
+            CORE_LOG_ERROR("[Server] Could not write metrics to {}", tmpPath);
+            return false;
+        }
+        if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+        {
+            //rename does not replace an existing file on Windows
+            std::remove(path.c_str());
+            if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+            {
+                CORE_LOG_ERROR("[Server] Could not move metrics to {}", path);
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -26,6 +26,11 @@ namespace game
         gameManager_.Update(dt);
     }
 
+    void SimulationClient::Tick()
+    {
+        gameManager_.Tick();
+    }
+
 
 
     void SimulationClient::Destroy()
@@ -50,19 +55,24 @@ namespace game
 
     }
 
+    void SimulationClient::Join()
+    {
+        auto joinPacket = std::make_unique<JoinPacket>();
+        const auto* clientIdPtr = reinterpret_cast<std::uint8_t*>(&clientId_);
+        for (std::size_t i = 0; i < sizeof(clientId_); i++)
+        {
+            joinPacket->clientId[i] = clientIdPtr[i];
+        }
+        SendReliablePacket(std::move(joinPacket));
+    }
+
     void SimulationClient::DrawImGui()
     {
         const auto windowName = "Client " + std::to_string(clientId_);
         ImGui::Begin(windowName.c_str());
         if (gameManager_.GetPlayerNumber() == INVALID_PLAYER && ImGui::Button("Spawn Player"))
         {
-            auto joinPacket = std::make_unique<JoinPacket>();
-            const auto* clientIdPtr = reinterpret_cast<std::uint8_t*>(&clientId_);
-            for (std::size_t i = 0; i < sizeof(clientId_); i++)
-            {
-                joinPacket->clientId[i] = clientIdPtr[i];
-            }
-            SendReliablePacket(std::move(joinPacket));
+            Join();
         }
         gameManager_.DrawImGui();
         ImGui::End();
@@ -1,6 +1,7 @@
 #include <network/pong_simulation_server.h>
 #include <network/pong_simulation_client.h>
 #include <imgui.h>
+#include <algorithm>
 #include <maths/basic.h>
 #include <utils/conversion.h>
 #include <utils/log.h>
@@ -19,41 +20,20 @@ namespace game
 
     void SimulationServer::Update(sf::Time dt)
     {
-        auto packetIt = receivedPackets_.begin();
-        while (packetIt != receivedPackets_.end())
+        currentTime_ += dt.asSeconds();
+        while (auto packet = PopDuePacket(receivedPackets_))
         {
-            packetIt->currentTime -= dt.asSeconds();
-            if (packetIt->currentTime <= 0.0f)
-            {
-                ProcessReceivePacket(std::move(packetIt->packet));
-
-                packetIt = receivedPackets_.erase(packetIt);
-            }
-            else
-            {
-                ++packetIt;
-            }
-
+            ProcessReceivePacket(std::move(packet));
         }
 
-        packetIt = sentPackets_.begin();
-        while (packetIt != sentPackets_.end())
+        while (auto packet = PopDuePacket(sentPackets_))
         {
-            packetIt->currentTime -= dt.asSeconds();
-            if (packetIt->currentTime <= 0.0f)
+            for (auto& client : clients_)
             {
-                for (auto& client : clients_)
-                {
-                    client->ReceivePacket(packetIt->packet.get());
-                }
-                packetIt->packet = nullptr;
-                packetIt = sentPackets_.erase(packetIt);
-            }
-            else
-            {
-                ++packetIt;
+                client->ReceivePacket(packet.get());
             }
         }
+        UpdateMetrics(dt);
     }
 
     void SimulationServer::Destroy()
@@ -73,17 +53,46 @@ namespace game
             avgDelay_ = (maxDelay + minDelay) / 2.0f;
             marginDelay_ = (maxDelay - minDelay) / 2.0f;
         }
+        ImGui::Text("Packets in flight: %zu to server, %zu to clients", receivedPackets_.size(), sentPackets_.size());
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            const auto& clientMetrics = metrics_.GetClientMetrics(playerNumber);
+            ImGui::Text("P%u: RTT %.0f ms, lost inputs %llu, validate lag %u", playerNumber + 1,
+                clientMetrics.roundTripTime.asSeconds() * 1000.0f,
+                static_cast<unsigned long long>(clientMetrics.inputPacketsLost),
+                clientMetrics.validateLag);
+        }
         ImGui::End();
     }
 
     void SimulationServer::PutPacketInSendingQueue(std::unique_ptr<Packet> packet)
     {
-        sentPackets_.push_back({ avgDelay_ + core::RandomRange(-marginDelay_, marginDelay_), std::move(packet) });
+        PushDelayPacket(sentPackets_, std::move(packet));
     }
 
     void SimulationServer::PutPacketInReceiveQueue(std::unique_ptr<Packet> packet)
     {
-        receivedPackets_.push_back({ avgDelay_ + core::RandomRange(-marginDelay_, marginDelay_), std::move(packet) });
+        PushDelayPacket(receivedPackets_, std::move(packet));
+    }
+
+    void SimulationServer::PushDelayPacket(std::vector<DelayPacket>& queue, std::unique_ptr<Packet> packet)
+    {
+        std::uniform_real_distribution<float> marginDistribution(-marginDelay_, marginDelay_);
+        const auto delay = avgDelay_ + marginDistribution(delayGenerator_);
+        queue.push_back({ currentTime_ + delay, packetSequence_++, std::move(packet) });
+        std::push_heap(queue.begin(), queue.end(), DelayPacketCompare{});
+    }
+
+    std::unique_ptr<Packet> SimulationServer::PopDuePacket(std::vector<DelayPacket>& queue)
+    {
+        if (queue.empty() || queue.front().deliveryTime > currentTime_)
+        {
+            return nullptr;
+        }
+        std::pop_heap(queue.begin(), queue.end(), DelayPacketCompare{});
+        auto packet = std::move(queue.back().packet);
+        queue.pop_back();
+        return packet;
     }
 
     void SimulationServer::SendReliablePacket(std::unique_ptr<Packet> packet)
@@ -96,6 +105,17 @@ namespace game
         PutPacketInSendingQueue(std::move(packet));
     }
 
+    void SimulationServer::SetDelay(float avgDelay, float marginDelay)
+    {
+        avgDelay_ = avgDelay;
+        marginDelay_ = marginDelay;
+    }
+
+    void SimulationServer::SetSeed(std::uint32_t seed)
+    {
+        delayGenerator_.seed(seed);
+    }
+
     void SimulationServer::ProcessReceivePacket(std::unique_ptr<Packet> packet)
     {
         Server::ReceivePacket(std::move(packet));
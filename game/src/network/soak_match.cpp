@@ -0,0 +1,116 @@
+#include <network/pong_soak_match.h>
+
+#include <chrono>
+
+namespace game
+{
+    SoakMatch::SoakMatch(std::uint32_t seed, const SoakSettings& settings) :
+        server_(clients_), settings_(settings), botGenerator_(seed)
+    {
+        for (auto& client : clients_)
+        {
+            client = std::make_unique<SimulationClient>(server_);
+            client->SetClock(clock_);
+        }
+        server_.SetClock(clock_);
+        server_.SetSeed(seed);
+        server_.SetGameSeed(seed);
+        server_.SetDelay(settings_.avgDelay, settings_.marginDelay);
+    }
+
+    void SoakMatch::Init()
+    {
+        server_.Init();
+        //Headless clients skip Init so no texture or font is loaded, client id 0 is reserved by the server client map
+        for (std::size_t i = 0; i < clients_.size(); i++)
+        {
+            clients_[i]->SetClientId(static_cast<ClientId>(i + 1));
+            clients_[i]->Join();
+        }
+    }
+
+    bool SoakMatch::Update()
+    {
+        if (IsOver())
+        {
+            return false;
+        }
+        const auto dt = sf::seconds(GameManager::FixedPeriod);
+        const bool hasStarted = HasStarted();
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            clients_[playerNumber]->SetPlayerInput(UpdateBotInput(botStates_[playerNumber]));
+        }
+
+        clock_.Advance(dt);
+        const auto start = std::chrono::steady_clock::now();
+        server_.Update(dt);
+        for (auto& client : clients_)
+        {
+            const auto& gameManager = client->GetGameManager();
+            if (hasStarted)
+            {
+                const Frame rollbackDepth = gameManager.GetCurrentFrame() - gameManager.GetLastValidateFrame();
+                result_.rollbackDepthSum += rollbackDepth;
+                result_.rollbackSamples++;
+                result_.maxRollbackDepth = std::max(result_.maxRollbackDepth, rollbackDepth);
+            }
+            client->Tick();
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        if (hasStarted)
+        {
+            result_.frameTimes.push_back(
+                std::chrono::duration<float, std::micro>(end - start).count());
+        }
+        result_.frameCount = clients_[0]->GetGameManager().GetCurrentFrame();
+        result_.desyncCount = 0;
+        bool finished = true;
+        for (auto& client : clients_)
+        {
+            const auto& gameManager = client->GetGameManager();
+            result_.desyncCount += gameManager.GetRollbackManager().GetDesyncCount();
+            finished = finished && (gameManager.GetState() & ClientGameManager::FINISHED);
+        }
+        result_.finished = finished;
+        return !IsOver();
+    }
+
+    bool SoakMatch::HasStarted() const
+    {
+        for (const auto& client : clients_)
+        {
+            if (!(client->GetGameManager().GetState() & ClientGameManager::STARTED))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool SoakMatch::IsOver() const
+    {
+        return result_.finished || result_.frameCount >= settings_.maxFrames;
+    }
+
+    PlayerInput SoakMatch::UpdateBotInput(BotState& botState)
+    {
+        //Bots hold a random direction for a random number of frames
+        if (botState.remainingFrames <= 0)
+        {
+            static constexpr std::array<PlayerInput, 3> botInputs =
+            {
+                PlayerInputEnum::NONE,
+                PlayerInputEnum::UP,
+                PlayerInputEnum::DOWN
+            };
+            std::uniform_int_distribution<std::size_t> inputDistribution(0, botInputs.size() - 1);
+            std::uniform_int_distribution<int> durationDistribution(5, 50);
+            botState.input = botInputs[inputDistribution(botGenerator_)];
+            botState.remainingFrames = durationDistribution(botGenerator_);
+        }
+        botState.remainingFrames--;
+        return botState.input;
+    }
+}
@@ -1,15 +1,23 @@
 
+#include <imgui.h>
+
 #include "engine/engine.h"
 #include "engine/system.h"
 #include "graphics/graphics.h"
 #include "network/pong_network_client.h"
+#include "utils/profiler.h"
 
 namespace game
 {
 
-    class ClientApp : public core::SystemInterface, public core::DrawImGuiInterface, public core::DrawInterface, public core::OnEventInterface
+    class ClientApp : public core::SystemInterface, public core::DrawImGuiInterface, public core::DrawInterface, public core::OnEventInterface,
+        public core::RenderSnapshotInterface
     {
     public:
+        explicit ClientApp(const core::Engine& engine) : engine_(engine)
+        {
+        }
+
         void Init() override
         {
             windowSize_ = core::windowSize;
@@ -36,6 +44,10 @@ namespace game
         void DrawImGui() override
         {
             client_.DrawImGui();
+            //Drawing goes through the engine sprite batch with threaded rendering
+            ImGui::Begin("Renderer");
+            ImGui::Text("Sprite draw calls: %zu", engine_.GetSpriteDrawCallCount());
+            ImGui::End();
         }
 
         void OnEvent(const sf::Event& event) override
@@ -56,7 +68,13 @@ namespace game
             client_.Draw(window);
         }
 
+        void WriteRenderSnapshot(core::RenderSnapshot& snapshot) override
+        {
+            client_.WriteRenderSnapshot(snapshot);
+        }
+
     private:
+        const core::Engine& engine_;
         sf::Vector2u windowSize_;
         ClientNetworkManager client_;
     };
@@ -65,11 +83,16 @@ namespace game
 int main()
 {
     core::Engine engine;
-    game::ClientApp app;
+    game::ClientApp app(engine);
     engine.RegisterSystem(&app);
     engine.RegisterDraw(&app);
     engine.RegisterDrawImGui(&app);
     engine.RegisterOnEvent(&app);
+    engine.RegisterRenderSnapshot(&app);
+    //Rollback resimulations run on their own thread and do not delay the presentation
+    engine.SetThreadedRendering(true);
+    engine.RegisterRenderImGui(&engine.GetFramePacer());
+    engine.RegisterRenderImGui(&core::Profiler::Get());
 
     engine.Run();
     return 0;
@@ -0,0 +1,87 @@
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "game/pong_replay.h"
+#include "utils/log.h"
+#include "utils/profiler.h"
+
+namespace
+{
+    float GetElapsedSeconds(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+/**
+ * \brief Plays a replay recorded by the server as fast as possible and checks it reproduces the recorded match.
+ * With a seek frame, also checks that seeking through the keyframes gives the same state as playing from the start.
+ * Usage: replay <replayPath> [seekFrame]
+ */
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fmt::print("Usage: replay <replayPath> [seekFrame]\n");
+        return EXIT_FAILURE;
+    }
+    core::SetLogLevel(core::LogLevel::Warning);
+    //Nothing reads the zones of the batch runs
+    core::Profiler::Get().SetEnabled(false);
+    game::Replay replay;
+    if (!replay.Load(argv[1]))
+    {
+        return EXIT_FAILURE;
+    }
+    const auto& header = replay.GetHeader();
+
+    auto start = std::chrono::steady_clock::now();
+    game::ReplayPlayer replayPlayer(replay);
+    replayPlayer.Init();
+    while (replayPlayer.Update())
+    {
+    }
+    auto wallTime = GetElapsedSeconds(start);
+
+    bool isMatching = replayPlayer.IsMatchingRecord();
+    fmt::print("Replayed {} frames in {:.3f}s ({:.0f} frames/s), {} keyframes\n",
+        header.frameCount, wallTime, wallTime > 0.0f ? static_cast<float>(header.frameCount) / wallTime : 0.0f,
+        header.keyframeCount);
+    fmt::print("Recorded winner: P{}, final state {}\n", header.winner + 1,
+        isMatching ? "matches the record" : "DOES NOT match the record");
+
+    if (argc >= 3)
+    {
+        const auto seekFrame = static_cast<game::Frame>(std::stoul(argv[2]));
+        start = std::chrono::steady_clock::now();
+        const bool isKeyframeSeekDone = replayPlayer.Seek(seekFrame);
+        const auto keyframeSeekTime = GetElapsedSeconds(start);
+
+        game::ReplayPlayer linearPlayer(replay);
+        linearPlayer.Init();
+        start = std::chrono::steady_clock::now();
+        const bool isLinearSeekDone = linearPlayer.Seek(seekFrame, false);
+        wallTime = GetElapsedSeconds(start);
+        if (!isKeyframeSeekDone || !isLinearSeekDone)
+        {
+            fmt::print("Seek to frame {} failed\n", seekFrame);
+            return EXIT_FAILURE;
+        }
+
+        bool isSeekMatching = true;
+        for (game::PlayerNumber playerNumber = 0; playerNumber < game::maxPlayerNmb; playerNumber++)
+        {
+            isSeekMatching = isSeekMatching &&
+                replayPlayer.GetGameManager().GetRollbackManager().GetValidatePhysicsState(playerNumber) ==
+                linearPlayer.GetGameManager().GetRollbackManager().GetValidatePhysicsState(playerNumber);
+        }
+        fmt::print("Seek to frame {}: {:.3f}ms with keyframes, {:.3f}ms from the start, states {}\n",
+            replayPlayer.GetCurrentFrame(), keyframeSeekTime * 1000.0f, wallTime * 1000.0f,
+            isSeekMatching ? "match" : "DO NOT match");
+        isMatching = isMatching && isSeekMatching;
+    }
+    return isMatching ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,11 +1,19 @@
 #include <string>
 
 #include "network/pong_network_server.h"
+#include "utils/log.h"
+#include "utils/profiler.h"
 
+/**
+ * \brief Usage: server [port] [replayPath] [tracePath] [metricsPath], the trace is a Chrome trace of the last profiled zones,
+ * the metrics are dumped periodically in the Prometheus text format for a textfile scraper
+ */
 int main(int argc, char** argv)
 {
+    //Packet logs are written by a background thread instead of the network loop
+    core::InitAsyncLogging();
     unsigned short port = 0;
-    if (argc == 2)
+    if (argc >= 2)
     {
         std::string portArg = argv[1];
         port = std::stoi(portArg);
@@ -15,12 +23,27 @@ int main(int argc, char** argv)
     {
         server.SetTcpPort(port);
     }
+    if (argc >= 3)
+    {
+        server.SetReplayPath(argv[2]);
+    }
+    if (argc >= 5)
+    {
+        server.SetMetricsPath(argv[4]);
+    }
     server.Init();
     sf::Clock clock;
     while (server.IsOpen())
     {
         const auto dt = clock.restart();
+        core::Profiler::Get().MarkFrame();
         server.Update(dt);
     }
+    server.Destroy();
+    if (argc >= 4)
+    {
+        core::Profiler::Get().WriteChromeTrace(argv[3]);
+    }
+    core::ShutdownLogging();
     return 0;
 }
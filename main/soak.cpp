@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "network/pong_soak_match.h"
+#include "utils/log.h"
+#include "utils/profiler.h"
+
+namespace
+{
+    struct SoakReport
+    {
+        std::uint32_t matchCount = 0;
+        std::uint32_t finishedMatches = 0;
+        std::uint32_t desyncMatches = 0;
+        std::uint64_t desyncCount = 0;
+        std::uint64_t frameCount = 0;
+        std::uint64_t rollbackDepthSum = 0;
+        std::uint64_t rollbackSamples = 0;
+        game::Frame maxRollbackDepth = 0;
+        std::vector<float> frameTimes;
+
+        void Add(const game::SoakMatchResult& result)
+        {
+            matchCount++;
+            finishedMatches += result.finished ? 1 : 0;
+            desyncMatches += result.desyncCount > 0 ? 1 : 0;
+            desyncCount += result.desyncCount;
+            frameCount += result.frameCount;
+            rollbackDepthSum += result.rollbackDepthSum;
+            rollbackSamples += result.rollbackSamples;
+            maxRollbackDepth = std::max(maxRollbackDepth, result.maxRollbackDepth);
+            frameTimes.insert(frameTimes.end(), result.frameTimes.begin(), result.frameTimes.end());
+        }
+
+        void Merge(const SoakReport& report)
+        {
+            matchCount += report.matchCount;
+            finishedMatches += report.finishedMatches;
+            desyncMatches += report.desyncMatches;
+            desyncCount += report.desyncCount;
+            frameCount += report.frameCount;
+            rollbackDepthSum += report.rollbackDepthSum;
+            rollbackSamples += report.rollbackSamples;
+            maxRollbackDepth = std::max(maxRollbackDepth, report.maxRollbackDepth);
+            frameTimes.insert(frameTimes.end(), report.frameTimes.begin(), report.frameTimes.end());
+        }
+    };
+
+    float Percentile(const std::vector<float>& sortedValues, float percentile)
+    {
+        if (sortedValues.empty())
+        {
+            return 0.0f;
+        }
+        const auto index = static_cast<std::size_t>(percentile * static_cast<float>(sortedValues.size() - 1));
+        return sortedValues[index];
+    }
+}
+
+/**
+ * \brief Plays matchCount headless matches between bots on threadCount threads and prints a report
+ * Usage: soak [matchCount] [threadCount]
+ */
+int main(int argc, char** argv)
+{
+    std::uint32_t matchCount = 100;
+    unsigned threadCount = std::max(1u, std::thread::hardware_concurrency());
+    if (argc >= 2)
+    {
+        matchCount = static_cast<std::uint32_t>(std::stoul(argv[1]));
+    }
+    if (argc >= 3)
+    {
+        threadCount = std::max(1u, static_cast<unsigned>(std::stoul(argv[2])));
+    }
+    //Per match logs would flood the output
+    core::SetLogLevel(core::LogLevel::Warning);
+    //Nothing reads the zones of the batch runs
+    core::Profiler::Get().SetEnabled(false);
+
+    const game::SoakSettings settings;
+    SoakReport report;
+    std::mutex reportMutex;
+    std::atomic<std::uint32_t> nextMatch{ 0 };
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < threadCount; i++)
+    {
+        workers.emplace_back([&]()
+        {
+            SoakReport localReport;
+            for (auto matchIndex = nextMatch++; matchIndex < matchCount; matchIndex = nextMatch++)
+            {
+                game::SoakMatch match(matchIndex, settings);
+                match.Init();
+                while (match.Update())
+                {
+                }
+                localReport.Add(match.GetResult());
+            }
+            std::scoped_lock lock(reportMutex);
+            report.Merge(localReport);
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    const auto wallTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+
+    std::sort(report.frameTimes.begin(), report.frameTimes.end());
+    const auto matchNmb = std::max(report.matchCount, 1u);
+    const auto simulatedTime = static_cast<float>(report.frameCount) * game::GameManager::FixedPeriod;
+    fmt::print("Soak test: {} matches on {} threads in {:.1f}s\n", report.matchCount, threadCount, wallTime);
+    fmt::print("Finished matches: {}/{} ({} stopped at the frame limit)\n",
+        report.finishedMatches, report.matchCount, report.matchCount - report.finishedMatches);
+    fmt::print("Desync rate: {:.2f}% of matches ({} desynced player states)\n",
+        100.0f * static_cast<float>(report.desyncMatches) / static_cast<float>(matchNmb), report.desyncCount);
+    fmt::print("Rollback depth: avg {:.2f} frames, max {} frames\n",
+        report.rollbackSamples == 0 ? 0.0 :
+        static_cast<double>(report.rollbackDepthSum) / static_cast<double>(report.rollbackSamples),
+        report.maxRollbackDepth);
+    fmt::print("Frame CPU time (us): p50 {:.1f}, p90 {:.1f}, p99 {:.1f}, max {:.1f}\n",
+        Percentile(report.frameTimes, 0.5f),
+        Percentile(report.frameTimes, 0.9f),
+        Percentile(report.frameTimes, 0.99f),
+        report.frameTimes.empty() ? 0.0f : report.frameTimes.back());
+    fmt::print("Simulated {} frames ({:.1f}x real time)\n",
+        report.frameCount, wallTime > 0.0f ? simulatedTime / wallTime : 0.0f);
+    return report.desyncMatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}